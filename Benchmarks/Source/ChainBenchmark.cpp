@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    ChainBenchmark.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ChainBenchmark.h"
+#include "ProcessorProbe.h"
+
+namespace {
+
+    const char* const bandNames[] = { "low", "mid", "high" };
+
+    /** Median over repetitions of the time per call of fn, in nanoseconds. */
+    template <typename Fn>
+    double measureNsPerCall(int numCalls, int repetitions, Fn&& fn) {
+        std::vector<double> times;
+
+        // One untimed pass to warm the caches and the branch predictors.
+        for (int i = 0; i < numCalls; ++i)
+            fn();
+
+        for (int r = 0; r < repetitions; ++r) {
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < numCalls; ++i)
+                fn();
+            const auto end = juce::Time::getHighResolutionTicks();
+
+            times.push_back(juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e9 / numCalls);
+        }
+
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    void setParameter(Multiband_compAudioProcessor& processor, Params::Names name, float value) {
+        auto* parameter = processor.apvts.getParameter(Params::GetParams().at(name));
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    struct BandState {
+        const char* name;
+        std::function<void(Multiband_compAudioProcessor&)> apply;
+    };
+
+    std::vector<BandState> getBandStates() {
+        using namespace Params;
+
+        return {
+            { "active",     [](auto&) {} },
+            { "bypassed",   [](auto& p) {
+                                setParameter(p, Bypassed_Low_Band, 1);
+                                setParameter(p, Bypassed_Mid_Band, 1);
+                                setParameter(p, Bypassed_High_Band, 1); } },
+            { "lowMuted",   [](auto& p) { setParameter(p, Mute_Low_Band, 1); } },
+            { "midSoloed",  [](auto& p) { setParameter(p, Solo_Mid_Band, 1); } },
+        };
+    }
+
+    /** Thresholds low enough that every band is compressing, like a real mix bus. */
+    void setCompressing(Multiband_compAudioProcessor& processor) {
+        using namespace Params;
+
+        for (auto name : { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band })
+            setParameter(processor, name, -24.0f);
+        for (auto name : { Ratio_Low_Band, Ratio_Mid_Band, Ratio_High_Band })
+            setParameter(processor, name, 4.0f);
+    }
+
+    void prepare(Multiband_compAudioProcessor& processor, double sampleRate, int numChannels, int blockSize) {
+        // The full-quality chain is what is being timed, not whatever the governor falls back to.
+        processor.setAdaptiveQuality(false);
+        processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    /** Loops over a few hundred milliseconds of noise, blockSize samples at a time. */
+    class Source {
+    public:
+        Source(int numChannels, int blockSize, double sampleRate, juce::int64 seed)
+            : audio(numChannels, juce::jmax(4 * blockSize, (int)(0.25 * sampleRate))), blockSize(blockSize) {
+            juce::Random random(seed);
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int n = 0; n < audio.getNumSamples(); ++n)
+                    audio.setSample(ch, n, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+            pointers.resize((size_t)numChannels);
+        }
+
+        const float* const* next() {
+            if (position + blockSize > audio.getNumSamples())
+                position = 0;
+
+            for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+                pointers[(size_t)ch] = audio.getReadPointer(ch, position);
+
+            position += blockSize;
+            return pointers.data();
+        }
+
+    private:
+        juce::AudioBuffer<float> audio;
+        std::vector<const float*> pointers;
+        int blockSize;
+        int position{ 0 };
+    };
+}
+
+//==============================================================================
+std::vector<ChainBenchmark::Result> ChainBenchmark::run(const Options& options) const {
+    std::vector<Result> results;
+
+    for (auto numChannels : options.channelCounts) {
+        for (auto sampleRate : options.sampleRates) {
+            for (auto blockSize : options.blockSizes) {
+                const auto numCalls = juce::jmax(1, options.samplesPerRepetition / blockSize);
+
+                auto add = [&](const juce::String& stage, const juce::String& state, double nsPerCall) {
+                    results.push_back({ stage, state, blockSize, sampleRate, numChannels,
+                                        juce::jmax(0.0, nsPerCall) / blockSize, juce::jmax(0.0, nsPerCall) });
+                };
+
+                auto measure = [&](auto&& fn) { return measureNsPerCall(numCalls, options.repetitions, fn); };
+
+                Source source(numChannels, blockSize, sampleRate, options.seed);
+
+                //==============================================================================
+                // The single stages, called through the probe on one prepared instance.
+                {
+                    juce::ScopedNoDenormals noDenormals;
+
+                    Multiband_compAudioProcessor processor;
+                    setCompressing(processor);
+                    prepare(processor, sampleRate, numChannels, blockSize);
+                    ProcessorProbe::updateState(processor);
+
+                    const auto split = measure([&] {
+                        ProcessorProbe::splitBands(processor, source.next(), numChannels, blockSize);
+                    });
+                    add("splitBands", "-", split);
+
+                    // A band has to be re-split before every call, compressing the same buffer
+                    // over and over would take it below the threshold. The split is subtracted.
+                    for (int band = 0; band < 3; ++band) {
+                        const auto splitAndCompress = measure([&] {
+                            ProcessorProbe::splitBands(processor, source.next(), numChannels, blockSize);
+                            ProcessorProbe::compressBand(processor, band, numChannels, blockSize);
+                        });
+                        add(juce::String("compressor.") + bandNames[band], "-", splitAndCompress - split);
+                    }
+
+                    add("updateState.unchanged", "-", measure([&] { ProcessorProbe::updateState(processor); }));
+
+                    // Every parameter moves between two values, so every coefficient is recomputed
+                    // each call. Setting the parameters is timed on its own and subtracted.
+                    const auto& parameters = processor.getParameters();
+                    auto flip = false;
+                    auto setAll = [&] {
+                        flip = !flip;
+                        for (auto* parameter : parameters)
+                            parameter->setValue(flip ? 0.25f : 0.75f);
+                    };
+
+                    const auto setOnly = measure(setAll);
+                    const auto setAndUpdate = measure([&] { setAll(); ProcessorProbe::updateState(processor); });
+                    add("updateState.allChanged", "-", setAndUpdate - setOnly);
+
+                    processor.releaseResources();
+                }
+
+                //==============================================================================
+                // The whole callback, once per band state. The block is refilled from the source
+                // before every call; the copy is timed on its own and subtracted.
+                juce::AudioBuffer<float> buffer(numChannels, blockSize);
+                juce::MidiBuffer midi;
+
+                auto refill = [&] {
+                    auto* const* input = source.next();
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        buffer.copyFrom(ch, 0, input[ch], blockSize);
+                };
+
+                const auto copyOnly = measure(refill);
+
+                for (auto& bandState : getBandStates()) {
+                    Multiband_compAudioProcessor processor;
+                    setCompressing(processor);
+                    bandState.apply(processor);
+                    prepare(processor, sampleRate, numChannels, blockSize);
+
+                    const auto total = measure([&] { refill(); processor.processBlock(buffer, midi); });
+                    add("processBlock", bandState.name, total - copyOnly);
+
+                    processor.releaseResources();
+                }
+            }
+        }
+    }
+
+    return results;
+}
+
+//==============================================================================
+juce::var ChainBenchmark::toJson(const std::vector<Result>& results, const juce::String& label) {
+    auto* machine = new juce::DynamicObject();
+    machine->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+    machine->setProperty("cores", juce::SystemStats::getNumPhysicalCpus());
+    machine->setProperty("mhz", juce::SystemStats::getCpuSpeedInMegahertz());
+    machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    machine->setProperty("kernels", DspKernels::getIsaName(DspKernels::getActiveIsa()));
+   #if JUCE_DEBUG
+    machine->setProperty("build", "debug");
+   #else
+    machine->setProperty("build", "release");
+   #endif
+
+    juce::Array<juce::var> entries;
+    for (auto& r : results) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("stage", r.stage);
+        entry->setProperty("state", r.state);
+        entry->setProperty("blockSize", r.blockSize);
+        entry->setProperty("sampleRate", r.sampleRate);
+        entry->setProperty("channels", r.numChannels);
+        entry->setProperty("nsPerSample", r.nsPerSample);
+        entry->setProperty("nsPerCall", r.nsPerCall);
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("format", "multiband_comp-bench/1");
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("machine", juce::var(machine));
+    root->setProperty("results", entries);
+
+    return juce::var(root);
+}
+
+std::vector<ChainBenchmark::Result> ChainBenchmark::fromJson(const juce::var& json) {
+    std::vector<Result> results;
+
+    if (auto* entries = json["results"].getArray()) {
+        for (auto& e : *entries) {
+            results.push_back({ e["stage"].toString(), e["state"].toString(),
+                                (int)e["blockSize"], (double)e["sampleRate"], (int)e["channels"],
+                                (double)e["nsPerSample"], (double)e["nsPerCall"] });
+        }
+    }
+
+    return results;
+}
+
+int ChainBenchmark::compare(const std::vector<Result>& baseline, const std::vector<Result>& current,
+                            double tolerance, juce::String& report) {
+    auto key = [](const Result& r) {
+        return r.stage + "/" + r.state + "/" + juce::String(r.blockSize) + "/"
+             + juce::String(r.sampleRate, 0) + "/" + juce::String(r.numChannels);
+    };
+
+    std::map<juce::String, const Result*> before;
+    for (auto& r : baseline)
+        before[key(r)] = &r;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+
+    report << column("stage", 24) << column("state", 11) << column("block", 7) << column("rate", 8) << column("ch", 4)
+           << column("before", 10) << column("after", 10) << "change" << juce::newLine;
+
+    int numRegressions = 0;
+
+    for (auto& r : current) {
+        const auto found = before.find(key(r));
+        if (found == before.end() || found->second->nsPerSample <= 0)
+            continue;
+
+        const auto change = r.nsPerSample / found->second->nsPerSample - 1.0;
+        const auto regressed = change > tolerance;
+        numRegressions += regressed ? 1 : 0;
+
+        report << column(r.stage, 24) << column(r.state, 11) << column(juce::String(r.blockSize), 7)
+               << column(juce::String(r.sampleRate, 0), 8) << column(juce::String(r.numChannels), 4)
+               << column(juce::String(found->second->nsPerSample, 3), 10) << column(juce::String(r.nsPerSample, 3), 10)
+               << (change >= 0 ? "+" : "") << juce::String(change * 100.0, 1) << "%"
+               << (regressed ? "  SLOWER" : "") << juce::newLine;
+    }
+
+    return numRegressions;
+}
+
+juce::String ChainBenchmark::formatReport(const std::vector<Result>& results) {
+    juce::String report;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+
+    report << column("stage", 24) << column("state", 11) << column("block", 7) << column("rate", 8) << column("ch", 4)
+           << column("ns/sample", 12) << "ns/call" << juce::newLine;
+
+    for (auto& r : results) {
+        report << column(r.stage, 24) << column(r.state, 11) << column(juce::String(r.blockSize), 7)
+               << column(juce::String(r.sampleRate, 0), 8) << column(juce::String(r.numChannels), 4)
+               << column(juce::String(r.nsPerSample, 3), 12) << juce::String(r.nsPerCall, 1) << juce::newLine;
+    }
+
+    return report;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ChainBenchmark.h
+    Created: 19 Oct 2026
+
+    Times the stages of Multiband_compAudioProcessor (splitBands, each
+    CompressorBand, updateState) and the whole processBlock over a sweep of
+    block sizes, sample rates, channel counts and band states.
+
+    Every figure is the median of several repetitions, in ns per sample and
+    ns per call. Results go out as JSON so two commits can be compared.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class ChainBenchmark {
+public:
+    struct Options {
+        std::vector<int> blockSizes{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+        std::vector<double> sampleRates{ 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+        /** The plugin only accepts mono and stereo layouts (isBusesLayoutSupported). */
+        std::vector<int> channelCounts{ 1, 2 };
+
+        /** Audio pushed through per repetition; short blocks get more calls. */
+        int samplesPerRepetition{ 1 << 16 };
+        int repetitions{ 7 };
+
+        juce::int64 seed{ 1 };
+    };
+
+    struct Result {
+        juce::String stage;         // splitBands, compressor.low, updateState.allChanged, processBlock...
+        juce::String state;         // band state for processBlock, "-" for the single stages
+        int blockSize{ 0 };
+        double sampleRate{ 0 };
+        int numChannels{ 0 };
+
+        double nsPerSample{ 0 };    // per sample frame, all channels together
+        double nsPerCall{ 0 };
+    };
+
+    std::vector<Result> run(const Options& options) const;
+
+    //==============================================================================
+    /** Results plus a description of the machine and build, see writeJson(). */
+    static juce::var toJson(const std::vector<Result>& results, const juce::String& label);
+    static std::vector<Result> fromJson(const juce::var& json);
+
+    /** One line per result found in both sets, with the relative change in ns/sample.
+        Returns the number of results slower than baseline by more than tolerance (0.05 = 5%).
+    */
+    static int compare(const std::vector<Result>& baseline, const std::vector<Result>& current,
+                       double tolerance, juce::String& report);
+
+    static juce::String formatReport(const std::vector<Result>& results);
+};
@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+    GraphScalingBenchmark.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "GraphScalingBenchmark.h"
+#include "ProcessorProbe.h"
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#endif
+
+namespace {
+
+    using Graph = juce::AudioProcessorGraph;
+
+    /** Resident set size of the process, 0 where we don't know how to read it. */
+    double getResidentBytes() {
+       #if JUCE_LINUX
+        const auto statm = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), false);
+        if (statm.size() > 1)
+            return statm[1].getDoubleValue() * (double)sysconf(_SC_PAGESIZE);
+       #endif
+        return 0;
+    }
+
+    struct CacheLevel {
+        juce::String name;
+        double bytes;
+    };
+
+    /** Data caches of the first core, smallest first. Empty where sysfs isn't available. */
+    std::vector<CacheLevel> getDataCaches() {
+        std::vector<CacheLevel> caches;
+
+       #if JUCE_LINUX
+        for (int i = 0;; ++i) {
+            const auto dir = juce::File("/sys/devices/system/cpu/cpu0/cache").getChildFile("index" + juce::String(i));
+            if (!dir.isDirectory())
+                break;
+
+            const auto type = dir.getChildFile("type").loadFileAsString().trim();
+            if (type == "Instruction")
+                continue;
+
+            const auto size = dir.getChildFile("size").loadFileAsString().trim();
+            auto bytes = size.getDoubleValue();
+            if (size.endsWithIgnoreCase("K")) bytes *= 1024.0;
+            if (size.endsWithIgnoreCase("M")) bytes *= 1024.0 * 1024.0;
+
+            const auto level = dir.getChildFile("level").loadFileAsString().trim();
+            caches.push_back({ "L" + level + (type == "Data" ? "d" : ""), bytes });
+        }
+       #endif
+
+        std::sort(caches.begin(), caches.end(), [](auto& a, auto& b) { return a.bytes < b.bytes; });
+        return caches;
+    }
+
+    /** Same settings as the single-instance benchmarks: every band compressing. */
+    std::unique_ptr<Multiband_compAudioProcessor> makeInstance() {
+        auto processor = std::make_unique<Multiband_compAudioProcessor>();
+
+        // Offline, each instance would otherwise fan its bands out over every core.
+        processor->setMaxRenderThreads(1);
+
+        // Real time, the governor would pick a tier from how long the blocks take, which is what is measured.
+        processor->setAdaptiveQuality(false);
+
+        using namespace Params;
+        for (auto name : { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band }) {
+            auto* parameter = processor->apvts.getParameter(GetParams().at(name));
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(-24.0f));
+        }
+
+        return processor;
+    }
+
+    struct Session {
+        Graph graph;
+        std::vector<Multiband_compAudioProcessor*> instances;
+    };
+
+    void build(Session& session, GraphScalingBenchmark::Topology topology, int numInstances,
+               const GraphScalingBenchmark::Options& options) {
+        auto& graph = session.graph;
+        graph.setPlayConfigDetails(options.numChannels, options.numChannels, options.sampleRate, options.blockSize);
+
+        const auto input = graph.addNode(std::make_unique<Graph::AudioGraphIOProcessor>(Graph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+        const auto output = graph.addNode(std::make_unique<Graph::AudioGraphIOProcessor>(Graph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+
+        auto connect = [&](Graph::NodeID source, Graph::NodeID destination) {
+            for (int ch = 0; ch < options.numChannels; ++ch)
+                graph.addConnection({ { source, ch }, { destination, ch } });
+        };
+
+        auto previous = input;
+
+        for (int i = 0; i < numInstances; ++i) {
+            auto processor = makeInstance();
+            processor->setPlayConfigDetails(options.numChannels, options.numChannels, options.sampleRate, options.blockSize);
+            session.instances.push_back(processor.get());
+
+            const auto node = graph.addNode(std::move(processor))->nodeID;
+
+            if (topology == GraphScalingBenchmark::Topology::serial) {
+                connect(previous, node);
+                previous = node;
+            }
+            else {
+                connect(input, node);
+                connect(node, output);
+            }
+        }
+
+        if (topology == GraphScalingBenchmark::Topology::serial)
+            connect(previous, output);
+
+        // On the message thread this builds the rendering sequence (and prepares every node) right away.
+        graph.setNonRealtime(options.offline);
+        graph.prepareToPlay(options.sampleRate, options.blockSize);
+    }
+}
+
+//==============================================================================
+std::vector<GraphScalingBenchmark::Result> GraphScalingBenchmark::run(const Options& options) const {
+    const auto caches = getDataCaches();
+    std::vector<Result> results;
+
+    juce::Random random(1);
+    juce::AudioBuffer<float> noise(options.numChannels, options.blockSize * 64);
+    for (int ch = 0; ch < noise.getNumChannels(); ++ch)
+        for (int n = 0; n < noise.getNumSamples(); ++n)
+            noise.setSample(ch, n, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+    for (auto topology : options.topologies) {
+        double baselineNs = 0;
+
+        for (auto numInstances : options.instanceCounts) {
+            Result result;
+            result.topology = topology;
+            result.numInstances = numInstances;
+
+            const auto residentBefore = getResidentBytes();
+
+            Session session;
+            build(session, topology, numInstances, options);
+
+            result.residentBytesPerInstance = juce::jmax(0.0, getResidentBytes() - residentBefore) / numInstances;
+            result.arenaBytesPerInstance = ProcessorProbe::getArenaSizeInBytes(*session.instances.front());
+
+            const auto workingSet = (double)result.arenaBytesPerInstance * numInstances;
+            result.workingSetFitsIn = "memory";
+            for (auto& cache : caches) {
+                if (workingSet <= cache.bytes) {
+                    result.workingSetFitsIn = cache.name;
+                    break;
+                }
+            }
+
+            //==============================================================================
+            juce::AudioBuffer<float> buffer(options.numChannels, options.blockSize);
+            juce::MidiBuffer midi;
+
+            const auto numBlocks = juce::jmax(1, (int)(options.secondsToRender * options.sampleRate / options.blockSize));
+            int position = 0;
+
+            auto renderSeconds = [&] {
+                juce::int64 ticks = 0;
+
+                for (int b = 0; b < numBlocks; ++b) {
+                    // Refilling the input is the host's job, it isn't timed.
+                    for (int ch = 0; ch < options.numChannels; ++ch)
+                        buffer.copyFrom(ch, 0, noise, ch, position, options.blockSize);
+                    position = (position + options.blockSize) % noise.getNumSamples();
+                    midi.clear();
+
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    session.graph.processBlock(buffer, midi);
+                    ticks += juce::Time::getHighResolutionTicks() - start;
+                }
+
+                return juce::Time::highResolutionTicksToSeconds(ticks);
+            };
+
+            renderSeconds();    // warm-up
+
+            std::vector<double> times;
+            for (int r = 0; r < options.repetitions; ++r)
+                times.push_back(renderSeconds());
+
+            std::sort(times.begin(), times.end());
+            const auto seconds = times[times.size() / 2];
+
+            const auto audioSeconds = (double)numBlocks * options.blockSize / options.sampleRate;
+            result.realtimeFactor = audioSeconds / seconds;
+            result.instancesPerCore = numInstances * result.realtimeFactor;
+            result.nsPerSamplePerInstance = seconds * 1.0e9 / ((double)numBlocks * options.blockSize * numInstances);
+
+            if (baselineNs <= 0)
+                baselineNs = result.nsPerSamplePerInstance;
+            result.slowdown = result.nsPerSamplePerInstance / baselineNs;
+
+            session.graph.releaseResources();
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+
+juce::String GraphScalingBenchmark::getTopologyName(Topology topology) {
+    return topology == Topology::serial ? "serial" : "parallel";
+}
+
+juce::String GraphScalingBenchmark::getQualityName(const Options& options) {
+    return options.offline ? juce::String("render (oversampled detector)")
+                           : juce::String(QualityGovernor::getTierName(QualityGovernor::full));
+}
+
+//==============================================================================
+juce::var GraphScalingBenchmark::toJson(const std::vector<Result>& results, const Options& options, const juce::String& label) {
+    auto* settings = new juce::DynamicObject();
+    settings->setProperty("sampleRate", options.sampleRate);
+    settings->setProperty("blockSize", options.blockSize);
+    settings->setProperty("channels", options.numChannels);
+    settings->setProperty("secondsToRender", options.secondsToRender);
+    settings->setProperty("offline", options.offline);
+    settings->setProperty("quality", getQualityName(options));
+    settings->setProperty("kernels", DspKernels::getIsaName(DspKernels::getActiveIsa()));
+
+    juce::Array<juce::var> caches;
+    for (auto& cache : getDataCaches()) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("level", cache.name);
+        entry->setProperty("bytes", cache.bytes);
+        caches.add(juce::var(entry));
+    }
+
+    juce::Array<juce::var> entries;
+    for (auto& r : results) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("topology", getTopologyName(r.topology));
+        entry->setProperty("instances", r.numInstances);
+        entry->setProperty("realtimeFactor", r.realtimeFactor);
+        entry->setProperty("instancesPerCore", r.instancesPerCore);
+        entry->setProperty("nsPerSamplePerInstance", r.nsPerSamplePerInstance);
+        entry->setProperty("slowdown", r.slowdown);
+        entry->setProperty("residentBytesPerInstance", r.residentBytesPerInstance);
+        entry->setProperty("arenaBytesPerInstance", (juce::int64)r.arenaBytesPerInstance);
+        entry->setProperty("workingSetFitsIn", r.workingSetFitsIn);
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("format", "multiband_comp-graph/1");
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+    root->setProperty("caches", caches);
+    root->setProperty("settings", juce::var(settings));
+    root->setProperty("results", entries);
+
+    return juce::var(root);
+}
+
+juce::String GraphScalingBenchmark::formatReport(const std::vector<Result>& results) {
+    juce::String report;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+
+    report << column("topology", 10) << column("instances", 11) << column("x realtime", 12) << column("inst/core", 11)
+           << column("ns/smp/inst", 13) << column("slowdown", 10) << column("RSS/inst", 11) << column("arena/inst", 12)
+           << "working set in" << juce::newLine;
+
+    for (auto& r : results) {
+        report << column(getTopologyName(r.topology), 10) << column(juce::String(r.numInstances), 11)
+               << column(juce::String(r.realtimeFactor, 1), 12) << column(juce::String(r.instancesPerCore, 0), 11)
+               << column(juce::String(r.nsPerSamplePerInstance, 2), 13) << column(juce::String(r.slowdown, 2) + "x", 10)
+               << column(r.residentBytesPerInstance > 0 ? juce::File::descriptionOfSizeInBytes((juce::int64)r.residentBytesPerInstance)
+                                                       : juce::String("n/a"), 11)
+               << column(juce::File::descriptionOfSizeInBytes((juce::int64)r.arenaBytesPerInstance), 12)
+               << r.workingSetFitsIn << juce::newLine;
+    }
+
+    return report;
+}
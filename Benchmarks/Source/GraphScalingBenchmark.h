@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    GraphScalingBenchmark.h
+    Created: 19 Oct 2026
+
+    Many instances in one session. Builds juce::AudioProcessorGraph sessions
+    shaped like test_filtr.filtergraph (audio in -> multiband_comp -> audio
+    out), with 1 to 512 processors either chained one after the other or
+    side by side between the same input and output. Each session is rendered
+    on one thread, as a real-time host would at full quality (the
+    QualityGovernor off), or with --offline as a bounce would, at render
+    quality with the oversampled detector.
+
+    Reports how many instances one core keeps up with in real time, the
+    memory each instance adds, and how the cost per instance grows once the
+    working set of all instances no longer fits in the caches.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class GraphScalingBenchmark {
+public:
+    enum class Topology {
+        serial,     // in -> 1 -> 2 -> ... -> N -> out
+        parallel    // in -> each of 1..N -> out, summed by the graph
+    };
+
+    struct Options {
+        std::vector<int> instanceCounts{ 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+        std::vector<Topology> topologies{ Topology::serial, Topology::parallel };
+
+        double sampleRate{ 48000.0 };
+        int blockSize{ 256 };
+        int numChannels{ 2 };
+
+        /** Renders non-realtime, at QualityGovernor::getRenderQuality, instead of at the full tier. */
+        bool offline{ false };
+
+        /** Audio rendered per repetition; the median repetition is reported. */
+        double secondsToRender{ 1.0 };
+        int repetitions{ 3 };
+    };
+
+    struct Result {
+        Topology topology{ Topology::serial };
+        int numInstances{ 0 };
+
+        double realtimeFactor{ 0 };             // seconds of audio rendered per second of CPU
+        double instancesPerCore{ 0 };           // numInstances * realtimeFactor
+        double nsPerSamplePerInstance{ 0 };
+        double slowdown{ 1 };                   // nsPerSamplePerInstance relative to the smallest session
+
+        double residentBytesPerInstance{ 0 };   // growth of the process RSS, Linux only
+        size_t arenaBytesPerInstance{ 0 };      // hot DSP state touched every block
+        juce::String workingSetFitsIn;          // smallest cache level holding every arena, or "memory"
+    };
+
+    std::vector<Result> run(const Options& options) const;
+
+    static juce::String getTopologyName(Topology);
+    static juce::String getQualityName(const Options&);
+
+    static juce::var toJson(const std::vector<Result>& results, const Options& options, const juce::String& label);
+    static juce::String formatReport(const std::vector<Result>& results);
+};
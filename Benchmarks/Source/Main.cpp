@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    multiband_comp_bench: headless benchmarks of the processing chain.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "ChainBenchmark.h"
+#include "GraphScalingBenchmark.h"
+#include "StressHarness.h"
+#include "../../Source/DspKernels.h"
+#include "../../Source/EquivalenceHarness.h"
+#include "../../Source/RealtimeGuard.h"
+#include "../../Source/TraceRecorder.h"
+
+namespace {
+
+    template <typename T>
+    std::vector<T> parseList(const juce::String& text) {
+        std::vector<T> values;
+        for (auto& token : juce::StringArray::fromTokens(text, ",", {}))
+            values.push_back((T)token.trim().getDoubleValue());
+        return values;
+    }
+
+    void selectKernels(const juce::ArgumentList& args) {
+        if (!args.containsOption("--isa"))
+            return;
+
+        const auto name = args.getValueForOption("--isa");
+        for (int i = 0; i < (int)DspKernels::Isa::numIsas; ++i) {
+            const auto isa = (DspKernels::Isa)i;
+            if (name == DspKernels::getIsaName(isa)) {
+                if (!DspKernels::forceIsa(isa))
+                    juce::ConsoleApplication::fail(name + " kernels are not available on this machine");
+                return;
+            }
+        }
+
+        juce::ConsoleApplication::fail("Unknown --isa: " + name);
+    }
+
+    void writeFile(const juce::String& path, const juce::String& text) {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+        if (!file.replaceWithText(text))
+            juce::ConsoleApplication::fail("Can't write " + file.getFullPathName());
+    }
+
+    void runBenchmarks(const juce::ArgumentList& args) {
+        selectKernels(args);
+
+        ChainBenchmark::Options options;
+
+        if (args.containsOption("--quick")) {
+            options.blockSizes = { 64, 512, 4096 };
+            options.sampleRates = { 48000.0 };
+            options.repetitions = 3;
+        }
+
+        if (args.containsOption("--block-sizes"))
+            options.blockSizes = parseList<int>(args.getValueForOption("--block-sizes"));
+        if (args.containsOption("--sample-rates"))
+            options.sampleRates = parseList<double>(args.getValueForOption("--sample-rates"));
+        if (args.containsOption("--channels"))
+            options.channelCounts = parseList<int>(args.getValueForOption("--channels"));
+        if (args.containsOption("--repetitions"))
+            options.repetitions = juce::jmax(1, args.getValueForOption("--repetitions").getIntValue());
+
+        const auto results = ChainBenchmark().run(options);
+        std::cout << ChainBenchmark::formatReport(results) << std::endl;
+
+        if (args.containsOption("--json"))
+            writeFile(args.getValueForOption("--json"),
+                      juce::JSON::toString(ChainBenchmark::toJson(results, args.getValueForOption("--label"))));
+
+        if (args.containsOption("--compare")) {
+            const auto baselineFile = args.getExistingFileForOption("--compare");
+            const auto baseline = ChainBenchmark::fromJson(juce::JSON::parse(baselineFile));
+
+            const auto tolerance = args.containsOption("--tolerance")
+                                 ? args.getValueForOption("--tolerance").getDoubleValue() / 100.0
+                                 : 0.05;
+
+            juce::String report;
+            const auto numSlower = ChainBenchmark::compare(baseline, results, tolerance, report);
+            std::cout << report << std::endl;
+
+            if (numSlower > 0)
+                juce::ConsoleApplication::fail(juce::String(numSlower) + " results slower than "
+                                               + baselineFile.getFileName(), 2);
+        }
+    }
+
+    void runStress(const juce::ArgumentList& args) {
+        selectKernels(args);
+
+        StressHarness::Options options;
+
+        if (args.containsOption("--sample-rate"))
+            options.sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+        if (args.containsOption("--block-size"))
+            options.preparedBlockSize = juce::jmax(1, args.getValueForOption("--block-size").getIntValue());
+        if (args.containsOption("--channels"))
+            options.numChannels = juce::jlimit(1, 2, args.getValueForOption("--channels").getIntValue());
+        if (args.containsOption("--seconds"))
+            options.secondsPerScenario = args.getValueForOption("--seconds").getDoubleValue();
+        if (args.containsOption("--seed"))
+            options.seed = args.getValueForOption("--seed").getLargeIntValue();
+        if (args.containsOption("--automation-points"))
+            options.maxAutomationPointsPerBlock = juce::jmax(0, args.getValueForOption("--automation-points").getIntValue());
+
+        // Best effort, needs rtprio rights on Linux. Without it the tail also shows scheduler noise.
+        if (args.containsOption("--realtime") && !juce::Thread::setCurrentThreadPriority(10))
+            std::cout << "Couldn't raise the thread priority, running at normal priority" << std::endl;
+
+        const auto results = StressHarness().run(options);
+        std::cout << StressHarness::formatReport(results, options) << std::endl;
+
+        if (args.containsOption("--json"))
+            writeFile(args.getValueForOption("--json"),
+                      juce::JSON::toString(StressHarness::toJson(results, options, args.getValueForOption("--label"))));
+
+        // Acceptance check for live use: the p99.9 call must stay under this share of its deadline.
+        if (args.containsOption("--max-load")) {
+            const auto maxLoad = args.getValueForOption("--max-load").getDoubleValue() / 100.0;
+
+            for (auto& r : results) {
+                if (r.load.p999 > maxLoad || r.allocations + r.locks > 0)
+                    juce::ConsoleApplication::fail(r.scenario + " is over budget", 2);
+            }
+        }
+    }
+
+    void runGraph(const juce::ArgumentList& args) {
+        selectKernels(args);
+
+        GraphScalingBenchmark::Options options;
+
+        if (args.containsOption("--instances"))
+            options.instanceCounts = parseList<int>(args.getValueForOption("--instances"));
+        if (args.containsOption("--topology")) {
+            const auto name = args.getValueForOption("--topology");
+            if (name == "serial")        options.topologies = { GraphScalingBenchmark::Topology::serial };
+            else if (name == "parallel") options.topologies = { GraphScalingBenchmark::Topology::parallel };
+            else juce::ConsoleApplication::fail("Unknown --topology: " + name);
+        }
+        if (args.containsOption("--block-size"))
+            options.blockSize = juce::jmax(1, args.getValueForOption("--block-size").getIntValue());
+        if (args.containsOption("--sample-rate"))
+            options.sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+        if (args.containsOption("--seconds"))
+            options.secondsToRender = args.getValueForOption("--seconds").getDoubleValue();
+        options.offline = args.containsOption("--offline");
+
+        const auto results = GraphScalingBenchmark().run(options);
+        std::cout << "Quality: " << GraphScalingBenchmark::getQualityName(options) << std::endl;
+        std::cout << GraphScalingBenchmark::formatReport(results) << std::endl;
+
+        if (args.containsOption("--json"))
+            writeFile(args.getValueForOption("--json"),
+                      juce::JSON::toString(GraphScalingBenchmark::toJson(results, options, args.getValueForOption("--label"))));
+    }
+
+    void runVerify(const juce::ArgumentList& args) {
+        EquivalenceHarness::Options options;
+
+        // Every argument that isn't an option is a recording; one that can't be read fails the run.
+        for (int i = 0; i < args.size(); ++i)
+            if (!args[i].isOption())
+                options.realSignals.add(args[i].resolveAsFile());
+
+        const auto results = EquivalenceHarness().run(options);
+        std::cout << EquivalenceHarness::formatReport(results) << std::endl;
+
+        if (!EquivalenceHarness::allPassed(results))
+            juce::ConsoleApplication::fail("Optimised chain is outside its bounds");
+
+        // --stress reports zero allocations and locks; that only means something if the guard counts them.
+        if (RealtimeGuard::isEnabled()) {
+            if (!RealtimeGuard::selfTest())
+                juce::ConsoleApplication::fail("RealtimeGuard missed an allocation or lock on the audio thread");
+            std::cout << "RealtimeGuard: allocations and locks on the audio thread are trapped" << std::endl;
+        }
+        else {
+            std::cout << "RealtimeGuard: not built in (MBC_ENABLE_RT_GUARD=0), not checked" << std::endl;
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor is a foleys::MagicProcessor, its GUI state wants a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "Usage: multiband_comp_bench [command] [options] [--trace=timeline.json]", true);
+
+    app.addDefaultCommand({ "--run",
+                            "--run [--quick] [--json=out.json] [--label=name] [--compare=baseline.json] [--tolerance=5]\n"
+                            "      [--block-sizes=16,64,...] [--sample-rates=44100,...] [--channels=1,2] [--repetitions=7] [--isa=avx2]",
+                            "Times splitBands, each CompressorBand, updateState and processBlock.",
+                            "Sweeps block sizes, sample rates, channel counts and mute/solo/bypass states and prints ns per sample. "
+                            "--json writes the results for later --compare runs; --compare exits with code 2 if any result "
+                            "got slower than the baseline by more than --tolerance percent.",
+                            runBenchmarks });
+
+    app.addCommand({ "--stress",
+                     "--stress [--seconds=30] [--block-size=256] [--sample-rate=48000] [--channels=2] [--seed=1]\n"
+                     "         [--automation-points=3] [--realtime] [--json=out.json] [--label=name] [--max-load=50] [--isa=avx2]",
+                     "Worst-case processBlock timing under hostile automation.",
+                     "Times every call while parameters move every block and inside blocks, crossovers sweep, bands toggle, block sizes "
+                     "vary up to four times the prepared size and the input decays into denormals. Prints p50/p99/p99.9/max "
+                     "per call and against the block's deadline; --max-load exits with code 2 if any scenario's p99.9 "
+                     "goes over that percentage of its deadline.",
+                     runStress });
+
+    app.addCommand({ "--graph",
+                     "--graph [--instances=1,2,...,512] [--topology=serial|parallel] [--block-size=256]\n"
+                     "        [--sample-rate=48000] [--seconds=1] [--offline] [--json=out.json] [--label=name] [--isa=avx2]",
+                     "Renders AudioProcessorGraph sessions with up to 512 instances.",
+                     "Serial and parallel sessions of 1 to 512 processors, rendered on one core at full quality, or with "
+                     "--offline non-realtime at render quality. Prints instances per core, RSS and DSP state per instance, "
+                     "and the cost per instance relative to the smallest session.",
+                     runGraph });
+
+    app.addCommand({ "--verify",
+                     "--verify [recordings...]",
+                     "Checks every kernel build against the frozen reference chain.",
+                     "Runs EquivalenceHarness over synthetic signals plus the given audio files, then checks that "
+                     "RealtimeGuard (if built in) counts an allocation and a lock made on the audio thread.",
+                     runVerify });
+
+    // --trace works with every command: a Chrome trace-event timeline of every instance.
+    const juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--trace")) {
+        const auto traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--trace"));
+        if (!TraceRecorder::start(traceFile))
+            std::cout << "Tracing is not available (build with MBC_ENABLE_TRACING=1)" << std::endl;
+    }
+
+    const auto result = app.findAndRunCommand(args);
+
+    if (TraceRecorder::isRecording()) {
+        TraceRecorder::stop();
+        if (const auto dropped = TraceRecorder::getNumDropped())
+            std::cout << "Trace: " << dropped << " events dropped, the writer couldn't keep up" << std::endl;
+    }
+
+    return result;
+}
@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    ProcessorProbe.h
+    Created: 19 Oct 2026
+
+    Reaches into Multiband_compAudioProcessor (it is a friend) so the
+    benchmarks can time each stage of processBlock on its own.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../Source/PluginProcessor.h"
+
+struct ProcessorProbe {
+
+    static void updateState(Multiband_compAudioProcessor& p) {
+        p.updateState();
+    }
+
+    static void splitBands(Multiband_compAudioProcessor& p, const float* const* input, int numChannels, int numSamples) {
+        p.engine.splitBands(input, numChannels, numSamples);
+    }
+
+    static void compressBand(Multiband_compAudioProcessor& p, int band, int numChannels, int numSamples) {
+        p.engine.compressBand(band, numChannels, numSamples);
+    }
+
+    static size_t getArenaSizeInBytes(const Multiband_compAudioProcessor& p) {
+        return p.engine.getArena().getSizeInBytes();
+    }
+};
@@ -0,0 +1,315 @@
+/*
+  ==============================================================================
+
+    StressHarness.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StressHarness.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace {
+
+    StressHarness::Percentiles percentilesOf(std::vector<double> values) {
+        StressHarness::Percentiles p;
+        if (values.empty())
+            return p;
+
+        std::sort(values.begin(), values.end());
+
+        auto at = [&values](double q) {
+            const auto index = (size_t)std::ceil(q * (double)values.size());
+            return values[juce::jlimit<size_t>(0, values.size() - 1, index > 0 ? index - 1 : 0)];
+        };
+
+        p.p50 = at(0.5);
+        p.p99 = at(0.99);
+        p.p999 = at(0.999);
+        p.max = values.back();
+        return p;
+    }
+
+    /** Two seconds of audio the callback copies its input from. */
+    juce::AudioBuffer<float> makeSignal(const StressHarness::Options& options, bool denormal, juce::Random& random) {
+        const auto numSamples = (int)(2.0 * options.sampleRate);
+        juce::AudioBuffer<float> signal(options.numChannels, numSamples);
+
+        const auto burstLength = (int)(0.05 * options.sampleRate);
+        const auto tinyStart = numSamples / 2;
+
+        for (int ch = 0; ch < options.numChannels; ++ch) {
+            for (int n = 0; n < numSamples; ++n) {
+                const auto noise = random.nextFloat() * 2.0f - 1.0f;
+
+                if (!denormal)
+                    signal.setSample(ch, n, noise * 0.5f);
+                else if (n < burstLength)
+                    signal.setSample(ch, n, noise);                 // loud burst...
+                else if (n < tinyStart)
+                    signal.setSample(ch, n, 0.0f);                  // ...then the filters and envelopes decay
+                else
+                    signal.setSample(ch, n, noise * 1.0e-39f);      // sub-normal input
+            }
+        }
+
+        return signal;
+    }
+
+    class Automation {
+    public:
+        Automation(Multiband_compAudioProcessor& processor, const StressHarness::Scenario& scenario, juce::Random& random)
+            : scenario(scenario), random(random) {
+            using namespace Params;
+            const auto& names = GetParams();
+
+            auto get = [&](Names name) { return processor.apvts.getParameter(names.at(name)); };
+
+            lowMid = get(Low_Mid_Crossover_Freq);
+            midHigh = get(Mid_High_Crossover_Freq);
+
+            for (auto name : { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band,
+                               Attack_Low_Band, Attack_Mid_Band, Attack_High_Band,
+                               Release_Low_Band, Release_Mid_Band, Release_High_Band,
+                               Ratio_Low_Band, Ratio_Mid_Band, Ratio_High_Band,
+                               Gain_In, Gain_Out })
+                continuous.push_back(get(name));
+
+            for (auto name : { Bypassed_Low_Band, Bypassed_Mid_Band, Bypassed_High_Band,
+                               Mute_Low_Band, Mute_Mid_Band, Mute_High_Band,
+                               Solo_Low_Band, Solo_Mid_Band, Solo_High_Band })
+                flags.push_back(get(name));
+        }
+
+        /** Moves the parameters for the block or piece starting at timeSeconds, like host automation would. */
+        void apply(double timeSeconds) {
+            if (scenario.crossoverSweep) {
+                const auto phase = std::fmod(timeSeconds, 1.0);
+                const auto triangle = (float)(phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase);
+                lowMid->setValueNotifyingHost(triangle);
+                midHigh->setValueNotifyingHost(1.0f - triangle);
+            }
+
+            if (scenario.randomAutomation) {
+                for (auto* parameter : continuous)
+                    parameter->setValueNotifyingHost(random.nextFloat());
+            }
+
+            if (scenario.toggleBands && random.nextInt(20) == 0) {
+                auto* flag = flags[(size_t)random.nextInt((int)flags.size())];
+                flag->setValueNotifyingHost(flag->getValue() < 0.5f ? 1.0f : 0.0f);
+            }
+        }
+
+    private:
+        const StressHarness::Scenario& scenario;
+        juce::Random& random;
+
+        juce::RangedAudioParameter* lowMid{ nullptr };
+        juce::RangedAudioParameter* midHigh{ nullptr };
+        std::vector<juce::RangedAudioParameter*> continuous, flags;
+    };
+}
+
+//==============================================================================
+std::vector<StressHarness::Scenario> StressHarness::getScenarios() {
+    std::vector<Scenario> scenarios;
+
+    scenarios.push_back({ "steady" });
+    scenarios.push_back({ "crossoverSweep", true });
+    scenarios.push_back({ "randomAutomation", false, true });
+    scenarios.push_back({ "bandToggling", false, false, true });
+    scenarios.push_back({ "denormals", false, false, false, true });
+    scenarios.push_back({ "everything", true, true, true, true });
+
+    return scenarios;
+}
+
+std::vector<StressHarness::Result> StressHarness::run(const Options& options) const {
+    std::vector<Result> results;
+
+    const auto maxHostBlock = options.oversizeFactor * options.preparedBlockSize;
+
+    for (auto& scenario : getScenarios()) {
+        juce::Random random(options.seed);
+
+        const auto signal = makeSignal(options, scenario.denormalSignal, random);
+
+        Multiband_compAudioProcessor processor;
+        processor.setAdaptiveQuality(false);    // the tail at full quality, not whatever the governor settles on
+        processor.setPlayConfigDetails(options.numChannels, options.numChannels,
+                                       options.sampleRate, options.preparedBlockSize);
+        processor.prepareToPlay(options.sampleRate, options.preparedBlockSize);
+
+        Automation automation(processor, scenario, random);
+
+        juce::AudioBuffer<float> buffer(options.numChannels, maxHostBlock);
+        juce::MidiBuffer midi;
+
+        auto nextBlockSize = [&] {
+            return random.nextBool() ? options.preparedBlockSize : 1 + random.nextInt(maxHostBlock);
+        };
+
+        const auto isAutomated = scenario.crossoverSweep || scenario.randomAutomation || scenario.toggleBands;
+        std::vector<int> cuts;
+        cuts.reserve((size_t)juce::jmax(0, options.maxAutomationPointsPerBlock) + 2);
+
+        const auto totalSamples = (juce::int64)(options.secondsPerScenario * options.sampleRate);
+
+        std::vector<double> callNs, load;
+        callNs.reserve((size_t)(totalSamples / (options.preparedBlockSize / 2) + 1));
+        load.reserve(callNs.capacity());
+
+        Result result;
+        result.scenario = scenario.name;
+
+        int position = 0;
+        auto worstLoad = 0.0;
+
+        RealtimeGuard::resetViolations();
+
+        // The first hundred calls are a warm-up and aren't recorded: they measure
+        // the cold caches after prepareToPlay, not the steady state.
+        for (juce::int64 done = 0, call = 0; done < totalSamples; ++call) {
+            const auto blockSize = nextBlockSize();
+
+            // Everything the host does between callbacks stays outside the timed region.
+            buffer.setSize(options.numChannels, blockSize, false, false, true);
+            if (position + blockSize > signal.getNumSamples())
+                position = 0;
+            for (int ch = 0; ch < options.numChannels; ++ch)
+                buffer.copyFrom(ch, 0, signal, ch, position, blockSize);
+            position += blockSize;
+
+            // Where the parameters move: the block start, then random points inside it.
+            cuts.assign(1, 0);
+            if (isAutomated && blockSize > 1) {
+                for (int i = random.nextInt(options.maxAutomationPointsPerBlock + 1); --i >= 0;)
+                    cuts.push_back(1 + random.nextInt(blockSize - 1));
+                std::sort(cuts.begin(), cuts.end());
+                cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+            }
+            cuts.push_back(blockSize);
+
+            juce::int64 ticks = 0;
+
+            for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+                automation.apply((double)(done + cuts[i]) / options.sampleRate);
+
+                juce::AudioBuffer<float> piece(buffer.getArrayOfWritePointers(), options.numChannels,
+                                               cuts[i], cuts[i + 1] - cuts[i]);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                processor.processBlock(piece, midi);
+                ticks += juce::Time::getHighResolutionTicks() - start;
+            }
+
+            done += blockSize;
+            if (call < 100)
+                continue;
+
+            const auto ns = juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e9;
+            const auto deadlineNs = blockSize / options.sampleRate * 1.0e9;
+
+            callNs.push_back(ns);
+            load.push_back(ns / deadlineNs);
+
+            if (ns > deadlineNs)
+                ++result.deadlineMisses;
+
+            if (load.back() > worstLoad) {
+                worstLoad = load.back();
+                result.worstBlockSize = blockSize;
+            }
+        }
+
+        result.allocations = RealtimeGuard::getNumViolations(RealtimeGuard::Violation::allocation)
+                           + RealtimeGuard::getNumViolations(RealtimeGuard::Violation::deallocation);
+        result.locks = RealtimeGuard::getNumViolations(RealtimeGuard::Violation::lock);
+
+        processor.releaseResources();
+
+        result.numCalls = (int)callNs.size();
+        result.nsPerCall = percentilesOf(std::move(callNs));
+        result.load = percentilesOf(std::move(load));
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+//==============================================================================
+juce::var StressHarness::toJson(const std::vector<Result>& results, const Options& options, const juce::String& label) {
+    auto percentiles = [](const Percentiles& p) {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("p50", p.p50);
+        object->setProperty("p99", p.p99);
+        object->setProperty("p99.9", p.p999);
+        object->setProperty("max", p.max);
+        return juce::var(object);
+    };
+
+    auto* settings = new juce::DynamicObject();
+    settings->setProperty("sampleRate", options.sampleRate);
+    settings->setProperty("channels", options.numChannels);
+    settings->setProperty("preparedBlockSize", options.preparedBlockSize);
+    settings->setProperty("oversizeFactor", options.oversizeFactor);
+    settings->setProperty("maxAutomationPointsPerBlock", options.maxAutomationPointsPerBlock);
+    settings->setProperty("secondsPerScenario", options.secondsPerScenario);
+    settings->setProperty("kernels", DspKernels::getIsaName(DspKernels::getActiveIsa()));
+    settings->setProperty("rtGuard", (bool)MBC_ENABLE_RT_GUARD);
+
+    juce::Array<juce::var> entries;
+    for (auto& r : results) {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("scenario", r.scenario);
+        entry->setProperty("calls", r.numCalls);
+        entry->setProperty("nsPerCall", percentiles(r.nsPerCall));
+        entry->setProperty("load", percentiles(r.load));
+        entry->setProperty("deadlineMisses", r.deadlineMisses);
+        entry->setProperty("worstBlockSize", r.worstBlockSize);
+        entry->setProperty("allocations", r.allocations);
+        entry->setProperty("locks", r.locks);
+        entries.add(juce::var(entry));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("format", "multiband_comp-stress/1");
+    root->setProperty("label", label);
+    root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+    root->setProperty("settings", juce::var(settings));
+    root->setProperty("results", entries);
+
+    return juce::var(root);
+}
+
+juce::String StressHarness::formatReport(const std::vector<Result>& results, const Options& options) {
+    juce::String report;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+    auto us = [](double ns) { return juce::String(ns / 1000.0, 2); };
+    auto percent = [](double load) { return juce::String(load * 100.0, 1) + "%"; };
+
+    report << "prepared " << options.preparedBlockSize << " samples at " << juce::String(options.sampleRate, 0)
+           << " Hz, " << options.numChannels << " channels, host blocks up to "
+           << options.oversizeFactor * options.preparedBlockSize << ", automation at up to "
+           << options.maxAutomationPointsPerBlock << " points inside a block" << juce::newLine << juce::newLine;
+
+    report << column("scenario", 18) << column("calls", 9)
+           << column("p50 us", 9) << column("p99 us", 9) << column("p99.9 us", 10) << column("max us", 9)
+           << column("p99.9 load", 12) << column("max load", 10) << column("misses", 8) << "rt violations" << juce::newLine;
+
+    for (auto& r : results) {
+        report << column(r.scenario, 18) << column(juce::String(r.numCalls), 9)
+               << column(us(r.nsPerCall.p50), 9) << column(us(r.nsPerCall.p99), 9)
+               << column(us(r.nsPerCall.p999), 10) << column(us(r.nsPerCall.max), 9)
+               << column(percent(r.load.p999), 12) << column(percent(r.load.max), 10)
+               << column(juce::String(r.deadlineMisses), 8)
+               << (MBC_ENABLE_RT_GUARD ? juce::String(r.allocations + r.locks) : juce::String("n/a"))
+               << juce::newLine;
+    }
+
+    return report;
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    StressHarness.h
+    Created: 19 Oct 2026
+
+    Worst-case timing of processBlock. Drives one processor like a hostile
+    host would - parameters moving every block, crossover sweeps, random block
+    sizes up to several times the prepared size, mute/solo/bypass toggling,
+    signals that decay into denormals - and times every single call.
+
+    What matters for live use is the tail, so the report is the p50, p99,
+    p99.9 and max of each call, in ns and as a fraction of its deadline
+    (the duration of the audio in that block).
+
+    Automation moves parameters inside host blocks too: like a host with
+    sample-accurate automation, the harness cuts those blocks at the change
+    points and calls processBlock once per piece. The pieces of one host
+    block count as one call, timed together against the whole block's
+    deadline.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class StressHarness {
+public:
+    struct Options {
+        double sampleRate{ 48000.0 };
+        int numChannels{ 2 };
+        int preparedBlockSize{ 256 };
+
+        /** Half of the host blocks have the prepared size, the other half a random size
+            between 1 and oversizeFactor * preparedBlockSize.
+        */
+        int oversizeFactor{ 4 };
+
+        /** In the automated scenarios, the most points inside one host block at which the
+            parameters move, each cutting the block there. 0 moves them at block starts only.
+        */
+        int maxAutomationPointsPerBlock{ 3 };
+
+        /** Simulated audio per scenario. */
+        double secondsPerScenario{ 30.0 };
+
+        juce::int64 seed{ 1 };
+    };
+
+    struct Scenario {
+        juce::String name;
+        bool crossoverSweep{ false };   // both crossovers swept back and forth, a full cycle per second
+        bool randomAutomation{ false }; // every threshold, attack, release, ratio and gain jumps every block
+        bool toggleBands{ false };      // mute, solo and bypass flags flipped at random
+        bool denormalSignal{ false };   // bursts into exact silence and sub-normal noise
+    };
+
+    struct Percentiles {
+        double p50{ 0 }, p99{ 0 }, p999{ 0 }, max{ 0 };
+    };
+
+    struct Result {
+        juce::String scenario;
+        int numCalls{ 0 };
+
+        Percentiles nsPerCall;
+        Percentiles load;           // call time / block duration, 1.0 = missed the deadline
+
+        int deadlineMisses{ 0 };
+        int worstBlockSize{ 0 };
+
+        // Only counted when built with MBC_ENABLE_RT_GUARD.
+        int allocations{ 0 };
+        int locks{ 0 };
+    };
+
+    static std::vector<Scenario> getScenarios();
+
+    std::vector<Result> run(const Options& options) const;
+
+    static juce::var toJson(const std::vector<Result>& results, const Options& options, const juce::String& label);
+    static juce::String formatReport(const std::vector<Result>& results, const Options& options);
+};
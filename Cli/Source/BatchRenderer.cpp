@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+
+namespace {
+
+    class RenderJob : public juce::ThreadPoolJob {
+    public:
+        RenderJob(BatchRenderer::Outcome& o, const Preset& p, const OfflineRenderer::Settings& s,
+                  juce::CriticalSection& l, std::function<void(const BatchRenderer::Outcome&)>& f)
+            : juce::ThreadPoolJob(o.job.input.getFileName()), outcome(o), preset(p), settings(s), lock(l), onFinished(f) {}
+
+        JobStatus runJob() override {
+            outcome.result = OfflineRenderer::renderFile(outcome.job.input, outcome.job.output, preset, settings, outcome.stats);
+
+            if (onFinished != nullptr) {
+                const juce::ScopedLock sl(lock);
+                onFinished(outcome);
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        BatchRenderer::Outcome& outcome;
+        const Preset& preset;
+        const OfflineRenderer::Settings& settings;
+        juce::CriticalSection& lock;
+        std::function<void(const BatchRenderer::Outcome&)>& onFinished;
+    };
+}
+
+//==============================================================================
+BatchRenderer::BatchRenderer(const Preset& p, const OfflineRenderer::Settings& s, int threads)
+    : preset(p), settings(s),
+      numThreads(threads > 0 ? threads : juce::SystemStats::getNumCpus()) {}
+
+std::vector<BatchRenderer::Outcome> BatchRenderer::run(std::vector<Job> jobs) {
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.input.getSize() > b.input.getSize(); });
+
+    std::vector<Outcome> outcomes(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+        outcomes[i].job = jobs[i];
+
+    juce::CriticalSection lock;
+    {
+        juce::ThreadPool pool(juce::jmin(numThreads, juce::jmax(1, (int)jobs.size())));
+
+        for (auto& outcome : outcomes)
+            pool.addJob(new RenderJob(outcome, preset, settings, lock, onFileFinished), true);
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    return outcomes;
+}
+
+juce::String BatchRenderer::formatReport(const std::vector<Outcome>& outcomes, double wallSeconds) {
+    juce::String report;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+
+    double audioSeconds = 0;
+    int numFailed = 0;
+
+    for (auto& o : outcomes) {
+        if (o.result.failed()) {
+            ++numFailed;
+            continue;
+        }
+        audioSeconds += (double)o.stats.numSamples / o.stats.sampleRate;
+    }
+
+    report << column("files", 12) << juce::String((int)outcomes.size() - numFailed) << " rendered, "
+           << juce::String(numFailed) << " failed" << juce::newLine
+           << column("audio", 12) << juce::String(audioSeconds, 1) << " s" << juce::newLine
+           << column("wall clock", 12) << juce::String(wallSeconds, 2) << " s" << juce::newLine
+           << column("speed", 12) << juce::String(wallSeconds > 0 ? audioSeconds / wallSeconds : 0.0, 1) << "x realtime"
+           << juce::newLine;
+
+    return report;
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 19 Oct 2026
+
+    Renders many files at once, one processor per file, on a pool with a
+    thread per core. Files are queued largest first and idle threads take
+    the next one, so a catalog of mixed lengths keeps every core busy until
+    the end instead of waiting on one long file picked up last.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OfflineRenderer.h"
+
+class BatchRenderer {
+public:
+    struct Job {
+        juce::File input, output;
+    };
+
+    struct Outcome {
+        Job job;
+        juce::Result result{ juce::Result::ok() };
+        OfflineRenderer::Stats stats;
+    };
+
+    /** numThreads <= 0 uses every core. */
+    BatchRenderer(const Preset& preset, const OfflineRenderer::Settings& settings, int numThreads = 0);
+
+    /** Called from the pool threads as each file finishes, under a lock. */
+    std::function<void(const Outcome&)> onFileFinished;
+
+    std::vector<Outcome> run(std::vector<Job> jobs);
+
+    static juce::String formatReport(const std::vector<Outcome>& outcomes, double wallSeconds);
+
+private:
+    const Preset& preset;
+    const OfflineRenderer::Settings settings;
+    const int numThreads;
+};
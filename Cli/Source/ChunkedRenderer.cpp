@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    ChunkedRenderer.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ChunkedRenderer.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace {
+
+    double toDecibels(double gain) {
+        return gain > 0 ? 20.0 * std::log10(gain) : -std::numeric_limits<double>::infinity();
+    }
+
+    /** Largest difference between the last numSamples of a and of b. */
+    double getMaxDifferenceOfEnds(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int numSamples) {
+        double maxDifference = 0;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch) {
+            const auto* x = a.getReadPointer(ch, a.getNumSamples() - numSamples);
+            const auto* y = b.getReadPointer(ch, b.getNumSamples() - numSamples);
+
+            for (int n = 0; n < numSamples; ++n)
+                maxDifference = juce::jmax(maxDifference, std::abs((double)x[n] - (double)y[n]));
+        }
+
+        return maxDifference;
+    }
+
+    struct Segment {
+        juce::int64 start{ 0 }, length{ 0 }, preRoll{ 0 };
+
+        juce::AudioBuffer<float> audio;
+        juce::AudioBuffer<float> preRollTail;   // output for the samples just before start
+
+        juce::Result result{ juce::Result::ok() };
+        std::atomic<bool> finished{ false };
+    };
+
+    class SegmentJob : public juce::ThreadPoolJob {
+    public:
+        SegmentJob(Segment& s, const juce::File& i, const Preset& p, const OfflineRenderer::Settings& st,
+                   int tail, juce::WaitableEvent& done)
+            : juce::ThreadPoolJob("segment"), segment(s), input(i), preset(p), settings(st),
+              tailLength(tail), segmentFinished(done) {}
+
+        JobStatus runJob() override {
+            render();
+            segment.finished = true;
+            segmentFinished.signal();
+            return jobHasFinished;
+        }
+
+    private:
+        void render() {
+            OfflineRenderer::AudioFiles files;
+            auto reader = files.openReader(input);
+            if (reader == nullptr) {
+                segment.result = juce::Result::fail("Can't read " + input.getFullPathName());
+                return;
+            }
+
+            const auto numChannels = (int)reader->numChannels;
+            const auto preRollStart = juce::jmax((juce::int64)0, segment.start - segment.preRoll);
+            const auto end = segment.start + segment.length;
+
+            auto processor = OfflineRenderer::createProcessor(preset, settings, reader->sampleRate, numChannels, preRollStart);
+
+            segment.audio.setSize(numChannels, (int)segment.length);
+            segment.preRollTail.setSize(numChannels, (int)juce::jmin((juce::int64)tailLength, segment.start - preRollStart));
+
+            const auto tailStart = segment.start - segment.preRollTail.getNumSamples();
+
+            juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+            juce::MidiBuffer midi;
+
+            for (auto position = preRollStart; position < end;) {
+                // Pre-roll blocks stop at the seam, so a block is either thrown away or kept.
+                const auto blockEnd = position < segment.start ? segment.start : end;
+                const auto numSamples = (int)juce::jmin((juce::int64)settings.blockSize, blockEnd - position);
+                buffer.setSize(numChannels, numSamples, false, false, true);
+
+                reader->read(&buffer, 0, numSamples, position, true, true);
+                processor->processBlock(buffer, midi);
+
+                if (position >= segment.start) {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        segment.audio.copyFrom(ch, (int)(position - segment.start), buffer, ch, 0, numSamples);
+                }
+                else if (position + numSamples > tailStart) {
+                    const auto from = (int)juce::jmax((juce::int64)0, tailStart - position);
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        segment.preRollTail.copyFrom(ch, (int)(position + from - tailStart), buffer, ch, from, numSamples - from);
+                }
+
+                position += numSamples;
+            }
+
+            processor->releaseResources();
+        }
+
+        Segment& segment;
+        const juce::File input;
+        const Preset& preset;
+        const OfflineRenderer::Settings& settings;
+        const int tailLength;
+        juce::WaitableEvent& segmentFinished;
+    };
+
+    /** The reference for verify: the same file through one processor, a segment at a time. */
+    class SerialRender {
+    public:
+        SerialRender(const juce::File& input, const Preset& preset, const OfflineRenderer::Settings& s)
+            : settings(s) {
+            reader = files.openReader(input);
+            if (reader != nullptr)
+                processor = OfflineRenderer::createProcessor(preset, settings, reader->sampleRate, (int)reader->numChannels);
+        }
+
+        /** Renders the next segment.length samples and returns the largest difference to segment.audio. */
+        double compare(const Segment& segment) {
+            const auto numChannels = (int)reader->numChannels;
+            juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+            juce::MidiBuffer midi;
+            double maxDifference = 0;
+
+            for (juce::int64 done = 0; done < segment.length;) {
+                const auto numSamples = (int)juce::jmin((juce::int64)settings.blockSize, segment.length - done);
+                buffer.setSize(numChannels, numSamples, false, false, true);
+
+                reader->read(&buffer, 0, numSamples, segment.start + done, true, true);
+                processor->processBlock(buffer, midi);
+
+                for (int ch = 0; ch < numChannels; ++ch) {
+                    const auto* serial = buffer.getReadPointer(ch);
+                    const auto* chunked = segment.audio.getReadPointer(ch, (int)done);
+
+                    for (int n = 0; n < numSamples; ++n)
+                        maxDifference = juce::jmax(maxDifference, std::abs((double)serial[n] - (double)chunked[n]));
+                }
+
+                done += numSamples;
+            }
+
+            return maxDifference;
+        }
+
+    private:
+        const OfflineRenderer::Settings& settings;
+        OfflineRenderer::AudioFiles files;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        std::unique_ptr<Multiband_compAudioProcessor> processor;
+    };
+}
+
+//==============================================================================
+ChunkedRenderer::ChunkedRenderer(const Preset& p, const OfflineRenderer::Settings& s, const Options& o)
+    : preset(p), settings(s), options(o) {}
+
+juce::Result ChunkedRenderer::render(const juce::File& input, const juce::File& output, Report& report) {
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    OfflineRenderer::AudioFiles files;
+    auto reader = files.openReader(input);
+    if (reader == nullptr)
+        return juce::Result::fail("Can't read " + input.getFullPathName());
+
+    const auto numChannels = (int)reader->numChannels;
+    const auto sampleRate = reader->sampleRate;
+    const auto length = reader->lengthInSamples;
+
+    if (numChannels < 1 || numChannels > 2)
+        return juce::Result::fail(input.getFileName() + ": only mono and stereo files are supported");
+
+    auto writer = files.createWriter(output, sampleRate, numChannels, (int)reader->bitsPerSample,
+                                     reader->metadataValues, settings);
+    if (writer == nullptr)
+        return juce::Result::fail("Can't write " + output.getFullPathName());
+
+    reader.reset();
+
+    const auto segmentLength = juce::jmax((juce::int64)settings.blockSize, (juce::int64)(options.segmentSeconds * sampleRate));
+    const auto tailLength = juce::jmax(1, (int)(0.05 * sampleRate));
+    const auto preRoll = juce::jmax((juce::int64)tailLength, (juce::int64)(options.preRollSeconds * sampleRate));
+    const auto maxPreRoll = juce::jmax(preRoll, (juce::int64)(options.maxPreRollSeconds * sampleRate));
+    const auto maxDeviation = juce::Decibels::decibelsToGain(options.maxDeviationDb, -400.0);
+
+    const auto numSegments = (int)((length + segmentLength - 1) / segmentLength);
+    const auto numThreads = options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus();
+
+    // Finished segments wait in memory until they are written, keep only a few ahead of the writer.
+    const auto maxSegmentsAhead = numThreads + 4;
+
+    std::vector<std::unique_ptr<Segment>> segments((size_t)numSegments);
+    juce::WaitableEvent segmentFinished;
+    juce::ThreadPool pool(numThreads);
+
+    auto submit = [&](int index, juce::int64 segmentPreRoll) {
+        auto segment = std::make_unique<Segment>();
+        segment->start = index * segmentLength;
+        segment->length = juce::jmin(segmentLength, length - segment->start);
+        segment->preRoll = segmentPreRoll;
+
+        pool.addJob(new SegmentJob(*segment, input, preset, settings, tailLength, segmentFinished), true);
+        segments[(size_t)index] = std::move(segment);
+    };
+
+    std::unique_ptr<SerialRender> serial;
+    if (options.verify)
+        serial = std::make_unique<SerialRender>(input, preset, settings);
+
+    report = {};
+    report.numSegments = numSegments;
+
+    // The segments' processors each measure only their own stretch, the output is measured here as it is written.
+    LoudnessMeter outputLoudness;
+    outputLoudness.prepare(sampleRate);
+
+    juce::AudioBuffer<float> previousTail;
+    auto numSubmitted = 0;
+
+    for (int next = 0; next < numSegments;) {
+        while (numSubmitted < numSegments && numSubmitted < next + maxSegmentsAhead)
+            submit(numSubmitted++, preRoll);
+
+        auto& segment = *segments[(size_t)next];
+        while (!segment.finished)
+            segmentFinished.wait(100);
+
+        if (segment.result.failed())
+            return segment.result;
+
+        if (next > 0) {
+            const auto numCompared = juce::jmin(segment.preRollTail.getNumSamples(), previousTail.getNumSamples());
+            const auto deviation = getMaxDifferenceOfEnds(segment.preRollTail, previousTail, numCompared);
+
+            const auto canExtend = segment.preRoll < maxPreRoll && segment.preRoll < segment.start;
+            if (deviation > maxDeviation && canExtend) {
+                submit(next, juce::jmin(maxPreRoll, 2 * segment.preRoll));
+                ++report.numRetries;
+                continue;
+            }
+
+            report.seamDeviationDb = juce::jmax(report.seamDeviationDb, toDecibels(deviation));
+            if (deviation > maxDeviation)
+                report.withinBound = false;
+        }
+
+        if (!writer->writeFromAudioSampleBuffer(segment.audio, 0, segment.audio.getNumSamples()))
+            return juce::Result::fail("Write error on " + output.getFullPathName());
+
+        outputLoudness.process(segment.audio.getArrayOfReadPointers(), numChannels, segment.audio.getNumSamples());
+
+        if (serial != nullptr)
+            report.serialDeviationDb = juce::jmax(report.serialDeviationDb, toDecibels(serial->compare(segment)));
+
+        const auto numTail = juce::jmin(tailLength, segment.audio.getNumSamples());
+        previousTail.setSize(numChannels, numTail);
+        for (int ch = 0; ch < numChannels; ++ch)
+            previousTail.copyFrom(ch, 0, segment.audio, ch, segment.audio.getNumSamples() - numTail, numTail);
+
+        segments[(size_t)next].reset();
+        ++next;
+    }
+
+    report.stats.numSamples = length;
+    report.stats.sampleRate = sampleRate;
+    report.stats.numChannels = numChannels;
+    report.stats.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    report.stats.outputLoudness = outputLoudness.getReading();
+
+    return juce::Result::ok();
+}
+
+juce::String ChunkedRenderer::formatReport(const Report& report, const Options& options) {
+    juce::String text;
+
+    auto column = [](const juce::String& s, int width) { return s.paddedRight(' ', width); };
+    auto decibels = [](double db) { return std::isinf(db) ? juce::String("-inf") : juce::String(db, 1); };
+
+    const auto audioSeconds = (double)report.stats.numSamples / report.stats.sampleRate;
+
+    text << column("segments", 18) << report.numSegments << " of " << juce::String(options.segmentSeconds, 1) << " s, "
+         << report.numRetries << " rendered again with a longer pre-roll" << juce::newLine
+         << column("audio", 18) << juce::String(audioSeconds, 1) << " s" << juce::newLine
+         << column("wall clock", 18) << juce::String(report.stats.seconds, 2) << " s ("
+         << juce::String(report.stats.getRealtimeFactor(), 1) << "x realtime)" << juce::newLine
+         << column("output loudness", 18) << OfflineRenderer::formatLoudness(report.stats.outputLoudness) << juce::newLine
+         << column("seam deviation", 18) << decibels(report.seamDeviationDb) << " dBFS (bound "
+         << juce::String(options.maxDeviationDb, 1) << ")" << (report.withinBound ? "" : "  OVER") << juce::newLine;
+
+    if (options.verify)
+        text << column("vs serial render", 18) << decibels(report.serialDeviationDb) << " dBFS" << juce::newLine;
+
+    return text;
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    ChunkedRenderer.h
+    Created: 19 Oct 2026
+
+    Renders one long file on every core. The file is cut into segments, each
+    rendered by its own processor. Before its segment, every processor runs
+    over a stretch of the preceding input (the pre-roll) and throws the
+    output away, so the crossover and envelope state is settled by the time
+    the segment starts. The segments are written in order as they finish.
+
+    Nothing after the seam can be compared with a serial render without
+    doing one, but the stretch just before it can: the end of a segment's
+    pre-roll covers the same samples as the end of the previous segment,
+    whose state had the whole segment to settle. The difference there is the
+    deviation at the seam; it only decays after it. A seam over the bound is
+    rendered again with twice the pre-roll, up to maxPreRollSeconds.
+
+    verify renders the file serially alongside and reports the real maximum
+    deviation, at the speed of a serial render.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OfflineRenderer.h"
+
+class ChunkedRenderer {
+public:
+    struct Options {
+        double segmentSeconds{ 30.0 };
+        double preRollSeconds{ 5.0 };       // ten times the longest release time
+        double maxPreRollSeconds{ 40.0 };
+        double maxDeviationDb{ -100.0 };    // dBFS, at any seam
+        int numThreads{ 0 };                // <= 0 uses every core
+        bool verify{ false };
+    };
+
+    struct Report {
+        OfflineRenderer::Stats stats;
+        int numSegments{ 0 };
+        int numRetries{ 0 };
+        double seamDeviationDb{ -std::numeric_limits<double>::infinity() };
+        double serialDeviationDb{ -std::numeric_limits<double>::infinity() };   // only with verify
+        bool withinBound{ true };
+    };
+
+    ChunkedRenderer(const Preset& preset, const OfflineRenderer::Settings& settings, const Options& options);
+
+    /** Fails on read or write errors; a deviation over the bound is only flagged in the report. */
+    juce::Result render(const juce::File& input, const juce::File& output, Report& report);
+
+    static juce::String formatReport(const Report& report, const Options& options);
+
+private:
+    const Preset& preset;
+    const OfflineRenderer::Settings settings;
+    const Options options;
+};
@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    multiband_comp_cli: renders audio files through the compressor without
+    a host or an editor.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#if JUCE_WINDOWS
+ #include <fcntl.h>
+ #include <io.h>
+#endif
+
+#include "BatchRenderer.h"
+#include "ChunkedRenderer.h"
+#include "OfflineRenderer.h"
+#include "PcmPipe.h"
+#include "Preset.h"
+#include "SweepRenderer.h"
+#include "../../Source/AutomationTimeline.h"
+#include "../../Source/TraceRecorder.h"
+
+namespace {
+
+    Preset loadPreset(const juce::ArgumentList& args) {
+        Preset preset;
+
+        if (args.containsOption("--preset")) {
+            const auto result = preset.load(args.getExistingFileForOption("--preset"));
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+
+        // --set may be repeated, ArgumentList only hands out the first value of an option.
+        for (int i = 0; i < args.size(); ++i) {
+            if (!args[i].isLongOption("--set"))
+                continue;
+
+            const auto result = preset.addOverride(args[i].getLongOptionValue().unquoted());
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+
+        return preset;
+    }
+
+    OfflineRenderer::Settings getSettings(const juce::ArgumentList& args) {
+        OfflineRenderer::Settings settings;
+
+        if (args.containsOption("--block-size"))
+            settings.blockSize = juce::jmax(32, args.getValueForOption("--block-size").getIntValue());
+        if (args.containsOption("--format"))
+            settings.outputFormat = args.getValueForOption("--format").trimCharactersAtStart(".").toLowerCase();
+        if (args.containsOption("--bits"))
+            settings.bitDepth = args.getValueForOption("--bits").getIntValue();
+
+        return settings;
+    }
+
+    /** --automation, converted to parameter values on a scratch instance. */
+    void loadAutomation(const juce::ArgumentList& args, AutomationTimeline& timeline, OfflineRenderer::Settings& settings) {
+        if (!args.containsOption("--automation"))
+            return;
+
+        Multiband_compAudioProcessor parameterHost;
+        const auto result = timeline.load(args.getExistingFileForOption("--automation"), parameterHost.apvts);
+        if (result.failed())
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+
+        settings.automation = &timeline;
+    }
+
+    /** Files as given, directories expanded to the audio files in them. */
+    juce::Array<juce::File> findInputs(const juce::ArgumentList& args) {
+        OfflineRenderer::AudioFiles audioFiles;
+        juce::Array<juce::File> inputs;
+
+        for (int i = 0; i < args.size(); ++i) {
+            if (args[i].isOption())
+                continue;
+
+            const auto file = args[i].resolveAsFile();
+
+            if (file.isDirectory()) {
+                for (auto& f : file.findChildFiles(juce::File::findFiles, false))
+                    if (audioFiles.isAudioFile(f))
+                        inputs.add(f);
+            }
+            else if (file.existsAsFile()) {
+                inputs.add(file);
+            }
+            else {
+                juce::ConsoleApplication::fail("No such file: " + args[i].text);
+            }
+        }
+
+        if (inputs.isEmpty())
+            juce::ConsoleApplication::fail("No input files");
+
+        return inputs;
+    }
+
+    /** --output-dir, or next to the input with --suffix (default _mbc, so the input isn't overwritten). */
+    juce::File getOutputFile(const juce::ArgumentList& args, const juce::File& input, const OfflineRenderer::Settings& settings) {
+        juce::File outputDirectory;
+        if (args.containsOption("--output-dir")) {
+            outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output-dir"));
+            if (!outputDirectory.createDirectory())
+                juce::ConsoleApplication::fail("Can't create " + outputDirectory.getFullPathName());
+        }
+
+        const auto suffix = args.containsOption("--suffix") ? args.getValueForOption("--suffix")
+                          : outputDirectory == juce::File() ? juce::String("_mbc") : juce::String();
+
+        const auto output = OfflineRenderer::getDefaultOutputFile(input, outputDirectory, suffix, settings);
+        if (output == input)
+            juce::ConsoleApplication::fail("Output would overwrite " + input.getFullPathName() + ", give --suffix or --output-dir");
+
+        return output;
+    }
+
+    void runRender(const juce::ArgumentList& args) {
+        const auto preset = loadPreset(args);
+        auto settings = getSettings(args);
+
+        AutomationTimeline automation;
+        loadAutomation(args, automation, settings);
+
+        std::vector<BatchRenderer::Job> jobs;
+        for (auto& input : findInputs(args))
+            jobs.push_back({ input, getOutputFile(args, input, settings) });
+
+        // A single file has nothing to run beside it, its processor gets the cores instead.
+        const auto numThreads = args.getValueForOption("--threads").getIntValue();
+        if (jobs.size() == 1)
+            settings.renderThreads = numThreads;
+
+        BatchRenderer renderer(preset, settings, numThreads);
+
+        renderer.onFileFinished = [](const BatchRenderer::Outcome& o) {
+            if (o.result.failed())
+                std::cout << "FAILED  " << o.result.getErrorMessage() << std::endl;
+            else
+                std::cout << "ok      " << o.job.output.getFileName() << "  ("
+                          << juce::String(o.stats.getRealtimeFactor(), 1) << "x realtime)  "
+                          << OfflineRenderer::formatLoudness(o.stats.outputLoudness) << " (input "
+                          << OfflineRenderer::formatLoudness(o.stats.inputLoudness) << ")" << std::endl;
+        };
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        const auto outcomes = renderer.run(std::move(jobs));
+        const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+        std::cout << juce::newLine << BatchRenderer::formatReport(outcomes, wallSeconds) << std::endl;
+
+        if (std::any_of(outcomes.begin(), outcomes.end(), [](const BatchRenderer::Outcome& o) { return o.result.failed(); }))
+            juce::ConsoleApplication::fail("Some files failed to render", 2);
+    }
+
+    void runChunked(const juce::ArgumentList& args) {
+        const auto preset = loadPreset(args);
+        auto settings = getSettings(args);
+
+        AutomationTimeline automation;
+        loadAutomation(args, automation, settings);
+
+        ChunkedRenderer::Options options;
+
+        if (args.containsOption("--segment"))
+            options.segmentSeconds = juce::jmax(1.0, args.getValueForOption("--segment").getDoubleValue());
+        if (args.containsOption("--pre-roll"))
+            options.preRollSeconds = args.getValueForOption("--pre-roll").getDoubleValue();
+        if (args.containsOption("--max-pre-roll"))
+            options.maxPreRollSeconds = args.getValueForOption("--max-pre-roll").getDoubleValue();
+        if (args.containsOption("--max-deviation"))
+            options.maxDeviationDb = args.getValueForOption("--max-deviation").getDoubleValue();
+        if (args.containsOption("--threads"))
+            options.numThreads = args.getValueForOption("--threads").getIntValue();
+        options.verify = args.containsOption("--verify");
+
+        ChunkedRenderer renderer(preset, settings, options);
+
+        for (auto& input : findInputs(args)) {
+            const auto output = getOutputFile(args, input, settings);
+
+            ChunkedRenderer::Report report;
+            const auto result = renderer.render(input, output, report);
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+
+            std::cout << output.getFileName() << juce::newLine << ChunkedRenderer::formatReport(report, options) << std::endl;
+
+            if (!report.withinBound)
+                juce::ConsoleApplication::fail(output.getFileName() + ": a seam is over --max-deviation even with the longest pre-roll", 2);
+        }
+    }
+
+    void runSweep(const juce::ArgumentList& args) {
+        const auto preset = loadPreset(args);
+        const auto settings = getSettings(args);
+
+        // The variants share their band split, which only plays the preset's crossovers.
+        if (args.containsOption("--automation"))
+            juce::ConsoleApplication::fail("--sweep doesn't replay --automation");
+
+        juce::StringArray axes;
+        for (int i = 0; i < args.size(); ++i)
+            if (args[i].isLongOption("--vary"))
+                axes.add(args[i].getLongOptionValue().unquoted());
+
+        std::vector<SweepRenderer::Variant> variants;
+        const auto grid = SweepRenderer::makeGrid(preset, axes, variants);
+        if (grid.failed())
+            juce::ConsoleApplication::fail(grid.getErrorMessage());
+
+        SweepRenderer renderer(settings, args.getValueForOption("--threads").getIntValue());
+
+        for (auto& input : findInputs(args)) {
+            auto outputDirectory = input.getParentDirectory();
+            if (args.containsOption("--output-dir")) {
+                outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output-dir"));
+                if (!outputDirectory.createDirectory())
+                    juce::ConsoleApplication::fail("Can't create " + outputDirectory.getFullPathName());
+            }
+
+            SweepRenderer::Report report;
+            const auto result = renderer.render(input, outputDirectory, variants, report);
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+
+            std::cout << input.getFileName() << juce::newLine << SweepRenderer::formatReport(variants, report) << std::endl;
+
+            const auto summary = outputDirectory.getChildFile(input.getFileNameWithoutExtension() + "_sweep.csv");
+            if (!summary.replaceWithText(SweepRenderer::toCsv(variants, report)))
+                juce::ConsoleApplication::fail("Can't write " + summary.getFullPathName());
+        }
+    }
+
+    void runPipe(const juce::ArgumentList& args) {
+        const auto preset = loadPreset(args);
+        auto settings = getSettings(args);
+
+        if (!args.containsOption("--block-size"))
+            settings.blockSize = 1024;
+
+        AutomationTimeline automation;
+        loadAutomation(args, automation, settings);
+
+        PcmPipe::Options options;
+
+        if (args.containsOption("--sample-rate"))
+            options.sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+        if (args.containsOption("--channels"))
+            options.numChannels = args.getValueForOption("--channels").getIntValue();
+        if (args.containsOption("--threads"))
+            settings.renderThreads = args.getValueForOption("--threads").getIntValue();
+        if (options.sampleRate <= 0 || options.numChannels < 1 || options.numChannels > 2)
+            juce::ConsoleApplication::fail("Needs a positive --sample-rate and 1 or 2 --channels");
+
+        auto getFormat = [&args](const juce::String& option, PcmPipe::SampleFormat& format) {
+            if (args.containsOption(option) && !PcmPipe::parseSampleFormat(args.getValueForOption(option), format))
+                juce::ConsoleApplication::fail("Unknown " + option + ": " + args.getValueForOption(option));
+        };
+
+        getFormat("--input-format", options.inputFormat);
+        getFormat("--output-format", options.outputFormat);
+
+       #if JUCE_WINDOWS
+        _setmode(_fileno(stdin), _O_BINARY);
+        _setmode(_fileno(stdout), _O_BINARY);
+       #endif
+
+        PcmPipe::Stats stats;
+        const auto result = PcmPipe::run(stdin, stdout, preset, settings, options, stats);
+        if (result.failed())
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+
+        // stdout carries the audio, everything else goes to stderr.
+        if (args.containsOption("--verbose"))
+            std::cerr << stats.numFrames << " frames in " << juce::String(stats.seconds, 2) << " s, output "
+                      << OfflineRenderer::formatLoudness(stats.outputLoudness) << " (input "
+                      << OfflineRenderer::formatLoudness(stats.inputLoudness) << ")" << std::endl;
+        if (stats.numBytesDropped > 0)
+            std::cerr << "Dropped " << stats.numBytesDropped << " bytes of an incomplete frame at the end of the input" << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor is a foleys::MagicProcessor, its GUI state wants a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "Usage: multiband_comp_cli [command] [options] [--trace=timeline.json]", true);
+
+    app.addDefaultCommand({ "--render",
+                            "--render files|directories... [--preset=state.xml] [--set=\"Name=value\"]... [--automation=lanes.csv]\n"
+                            "         [--output-dir=dir] [--suffix=_mbc] [--format=wav|aiff|flac] [--bits=24]\n"
+                            "         [--block-size=8192] [--threads=N]",
+                            "Renders WAV, AIFF and FLAC files through the compressor, one file per core.",
+                            "--preset takes the state blob from getStateInformation or the parameters as XML; --set overrides "
+                            "single parameters by their name in Params::GetParams(), in real units (\"Threshold Low Band=-18\"). "
+                            "--automation replays parameter,sample,value points (CSV or JSON, same names and units) at their "
+                            "exact samples, with no need for smaller blocks. "
+                            "Output goes next to each input with --suffix, or into --output-dir, in the input's format and bit "
+                            "depth unless --format or --bits say otherwise. A single file is split across --threads cores by "
+                            "band and channel instead, with the same output as a serial render. Exits with code 2 if any file fails.",
+                            runRender });
+
+    app.addCommand({ "--chunked",
+                     "--chunked files... [--segment=30] [--pre-roll=5] [--max-pre-roll=40] [--max-deviation=-100] [--verify]\n"
+                     "          [--threads=N] and the options of --render",
+                     "Renders each file on every core, in segments with a pre-roll.",
+                     "For files too long to wait for one core: segments of --segment seconds are rendered in parallel, "
+                     "each after --pre-roll seconds of the preceding input to settle the filters and envelopes. Each seam's "
+                     "deviation is measured on the overlap; seams over --max-deviation dBFS are rendered again with a longer "
+                     "pre-roll, up to --max-pre-roll, and the command exits with code 2 if one stays over. --verify also "
+                     "renders serially and reports the real maximum deviation, at serial speed.",
+                     runChunked });
+
+    app.addCommand({ "--sweep",
+                     "--sweep files... --vary=\"Name=value,value,...\"... [--preset=state.xml] [--set=\"Name=value\"]...\n"
+                     "        [--output-dir=dir] [--format=wav|aiff|flac] [--bits=24] [--block-size=8192] [--threads=N]",
+                     "Renders every combination of the --vary values, splitting the bands once.",
+                     "Each --vary is one axis of the grid, on top of --preset and --set. Variants with the same crossover "
+                     "frequencies and input gain share one band split; their compressors run in parallel. Writes "
+                     "<name>_sweep_<n> per variant and <name>_sweep.csv with peak, RMS, crest factor, level change, integrated loudness and true peak.",
+                     runSweep });
+
+    app.addCommand({ "--pipe",
+                     "--pipe [--sample-rate=48000] [--channels=2] [--input-format=f32|s16|s24|s32] [--output-format=f32|...]\n"
+                     "       [--block-size=1024] [--threads=1] [--preset=state.xml] [--set=\"Name=value\"]... [--automation=lanes.csv]",
+                     "Streams raw interleaved PCM from stdin through the compressor to stdout.",
+                     "Little-endian PCM, float or 16/24/32-bit integer, converted while it is (de)interleaved. Processes and "
+                     "flushes one --block-size block at a time, which bounds the memory and latency of the stage. --threads "
+                     "splits each block by band and channel (0 for every core). Runs until stdin ends; messages go to stderr.",
+                     runPipe });
+
+    const juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--trace")) {
+        const auto traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--trace"));
+        if (!TraceRecorder::start(traceFile))
+            std::cerr << "Tracing is not available (build with MBC_ENABLE_TRACING=1)" << std::endl;
+    }
+
+    const auto result = app.findAndRunCommand(args);
+
+    if (TraceRecorder::isRecording()) {
+        TraceRecorder::stop();
+        if (const auto dropped = TraceRecorder::getNumDropped())
+            std::cerr << "Trace: " << dropped << " events dropped, the writer couldn't keep up" << std::endl;
+    }
+
+    return result;
+}
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "../../Source/AutomationTimeline.h"
+
+namespace OfflineRenderer {
+
+    AudioFiles::AudioFiles() {
+        formats.registerFormat(new juce::WavAudioFormat(), true);
+        formats.registerFormat(new juce::AiffAudioFormat(), false);
+        formats.registerFormat(new juce::FlacAudioFormat(), false);
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> AudioFiles::openReader(const juce::File& file) {
+        if (auto* format = formats.findFormatForFileExtension(file.getFileExtension())) {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+            if (mapped != nullptr && mapped->mapEntireFile())
+                return mapped;
+        }
+
+        return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> AudioFiles::createWriter(const juce::File& file, double sampleRate, int numChannels,
+                                                                      int inputBitDepth, const juce::StringPairArray& metadata,
+                                                                      const Settings& settings) {
+        auto* format = formats.findFormatForFileExtension(file.getFileExtension());
+        if (format == nullptr)
+            return {};
+
+        // The requested depth if the format has it, else the deepest one it has (FLAC stops at 24).
+        const auto depths = format->getPossibleBitDepths();
+        auto bitDepth = settings.bitDepth > 0 ? settings.bitDepth : inputBitDepth;
+        if (!depths.contains(bitDepth))
+            bitDepth = depths[depths.size() - 1];
+
+        file.deleteFile();
+        auto stream = file.createOutputStream();
+        if (stream == nullptr)
+            return {};
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate, (unsigned int)numChannels,
+                                                                                bitDepth, metadata, 0));
+        if (writer != nullptr)
+            stream.release();   // the writer owns it now
+
+        return writer;
+    }
+
+    bool AudioFiles::isAudioFile(const juce::File& file) const {
+        return formats.findFormatForFileExtension(file.getFileExtension()) != nullptr;
+    }
+
+    //==============================================================================
+    std::unique_ptr<Multiband_compAudioProcessor> createProcessor(const Preset& preset, const Settings& settings,
+                                                                  double sampleRate, int numChannels,
+                                                                  juce::int64 startSample) {
+        auto processor = std::make_unique<Multiband_compAudioProcessor>();
+        preset.applyTo(*processor);
+
+        processor->setNonRealtime(true);
+        processor->setMaxRenderThreads(settings.renderThreads);
+        processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, settings.blockSize);
+        processor->prepareToPlay(sampleRate, settings.blockSize);
+
+        if (settings.automation != nullptr)
+            processor->setAutomation(settings.automation, startSample);
+
+        return processor;
+    }
+
+    juce::String formatLoudness(const LoudnessMeter::Reading& reading) {
+        return LoudnessMeter::toString(reading.integrated) + " LUFS, " + LoudnessMeter::toString(reading.truePeak) + " dBTP";
+    }
+
+    juce::File getDefaultOutputFile(const juce::File& input, const juce::File& outputDirectory,
+                                    const juce::String& suffix, const Settings& settings) {
+        const auto directory = outputDirectory == juce::File() ? input.getParentDirectory() : outputDirectory;
+        const auto extension = settings.outputFormat.isNotEmpty() ? "." + settings.outputFormat.trimCharactersAtStart(".")
+                                                                  : input.getFileExtension();
+
+        return directory.getChildFile(input.getFileNameWithoutExtension() + suffix + extension);
+    }
+
+    juce::Result renderFile(const juce::File& input, const juce::File& output,
+                            const Preset& preset, const Settings& settings, Stats& stats) {
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        AudioFiles files;
+        auto reader = files.openReader(input);
+        if (reader == nullptr)
+            return juce::Result::fail("Can't read " + input.getFullPathName());
+
+        const auto numChannels = (int)reader->numChannels;
+        if (numChannels < 1 || numChannels > 2)
+            return juce::Result::fail(input.getFileName() + ": only mono and stereo files are supported");
+
+        auto writer = files.createWriter(output, reader->sampleRate, numChannels, (int)reader->bitsPerSample,
+                                         reader->metadataValues, settings);
+        if (writer == nullptr)
+            return juce::Result::fail("Can't write " + output.getFullPathName());
+
+        auto processor = createProcessor(preset, settings, reader->sampleRate, numChannels);
+
+        juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+
+        for (juce::int64 position = 0; position < reader->lengthInSamples;) {
+            const auto numSamples = (int)juce::jmin((juce::int64)settings.blockSize, reader->lengthInSamples - position);
+            buffer.setSize(numChannels, numSamples, false, false, true);
+
+            reader->read(&buffer, 0, numSamples, position, true, true);
+            processor->processBlock(buffer, midi);
+
+            if (!writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+                return juce::Result::fail("Write error on " + output.getFullPathName());
+
+            position += numSamples;
+        }
+
+        stats.inputLoudness = processor->getInputLoudness();
+        stats.outputLoudness = processor->getOutputLoudness();
+
+        processor->releaseResources();
+
+        stats.numSamples = reader->lengthInSamples;
+        stats.sampleRate = reader->sampleRate;
+        stats.numChannels = numChannels;
+        stats.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+        return juce::Result::ok();
+    }
+}
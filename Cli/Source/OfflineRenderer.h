@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 19 Oct 2026
+
+    Renders audio files through Multiband_compAudioProcessor without a host:
+    one editor-less processor per file, large blocks, memory-mapped reads
+    where the format allows it (WAV, AIFF).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Preset.h"
+#include "../../Source/LoudnessMeter.h"
+
+class AutomationTimeline;
+class Multiband_compAudioProcessor;
+
+namespace OfflineRenderer {
+
+    struct Settings {
+        int blockSize{ 8192 };
+
+        /** File extension of the output ("wav", "aiff", "flac"), empty to keep the input's. */
+        juce::String outputFormat;
+        /** 0 keeps the input's bit depth where the output format supports it. */
+        int bitDepth{ 0 };
+
+        /** Cores each processor may use (Multiband_compAudioProcessor::setMaxRenderThreads),
+            0 for all. 1 by default: the renderers already run files or segments in parallel.
+        */
+        int renderThreads{ 1 };
+
+        /** Replayed sample-accurately from the start of each file, if set. */
+        const AutomationTimeline* automation{ nullptr };
+    };
+
+    struct Stats {
+        juce::int64 numSamples{ 0 };
+        double sampleRate{ 0 };
+        int numChannels{ 0 };
+        double seconds{ 0 };
+
+        /** Of the whole file, from the processor's meters (the chunked renderer only measures the output). */
+        LoudnessMeter::Reading inputLoudness, outputLoudness;
+
+        double getRealtimeFactor() const { return seconds > 0 ? numSamples / sampleRate / seconds : 0.0; }
+    };
+
+    /** Format manager with WAV, AIFF and FLAC; one per thread, it isn't shared. */
+    class AudioFiles {
+    public:
+        AudioFiles();
+
+        /** Memory-mapped where the format supports it, a plain reader otherwise. */
+        std::unique_ptr<juce::AudioFormatReader> openReader(const juce::File& file);
+
+        std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, double sampleRate, int numChannels,
+                                                              int inputBitDepth, const juce::StringPairArray& metadata,
+                                                              const Settings& settings);
+
+        bool isAudioFile(const juce::File& file) const;
+
+    private:
+        juce::AudioFormatManager formats;
+    };
+
+    /** A processor set up for offline rendering: preset applied, non-realtime, prepared, and
+        replaying the settings' automation from startSample, the first sample it will process.
+    */
+    std::unique_ptr<Multiband_compAudioProcessor> createProcessor(const Preset& preset, const Settings& settings,
+                                                                  double sampleRate, int numChannels,
+                                                                  juce::int64 startSample = 0);
+
+    /** "-14.0 LUFS, -1.2 dBTP": integrated loudness and true peak. */
+    juce::String formatLoudness(const LoudnessMeter::Reading& reading);
+
+    /** Where renderFile writes when no output file is given. */
+    juce::File getDefaultOutputFile(const juce::File& input, const juce::File& outputDirectory,
+                                    const juce::String& suffix, const Settings& settings);
+
+    juce::Result renderFile(const juce::File& input, const juce::File& output,
+                            const Preset& preset, const Settings& settings, Stats& stats);
+}
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    PcmPipe.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PcmPipe.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace PcmPipe {
+
+    namespace {
+
+        // One sample of each format to and from float, full scale at +-1.
+        template <SampleFormat format>
+        struct Sample;
+
+        template <>
+        struct Sample<SampleFormat::float32> {
+            static float read(const juce::uint8* p) noexcept {
+                float value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+
+            static void write(juce::uint8* p, float value) noexcept {
+                std::memcpy(p, &value, sizeof(value));
+            }
+        };
+
+        template <>
+        struct Sample<SampleFormat::int16> {
+            static float read(const juce::uint8* p) noexcept {
+                return (float)(juce::int16)(p[0] | (p[1] << 8)) * (1.0f / 32768.0f);
+            }
+
+            static void write(juce::uint8* p, float value) noexcept {
+                const auto v = juce::jlimit(-32768, 32767, juce::roundToInt(value * 32768.0f));
+                p[0] = (juce::uint8)v;
+                p[1] = (juce::uint8)(v >> 8);
+            }
+        };
+
+        template <>
+        struct Sample<SampleFormat::int24> {
+            static float read(const juce::uint8* p) noexcept {
+                // Into the top three bytes of an int32, the shift back extends the sign.
+                const auto v = (juce::int32)(((juce::uint32)p[0] << 8) | ((juce::uint32)p[1] << 16) | ((juce::uint32)p[2] << 24)) >> 8;
+                return (float)v * (1.0f / 8388608.0f);
+            }
+
+            static void write(juce::uint8* p, float value) noexcept {
+                const auto v = juce::jlimit(-8388608, 8388607, juce::roundToInt(value * 8388608.0f));
+                p[0] = (juce::uint8)v;
+                p[1] = (juce::uint8)(v >> 8);
+                p[2] = (juce::uint8)(v >> 16);
+            }
+        };
+
+        template <>
+        struct Sample<SampleFormat::int32> {
+            static float read(const juce::uint8* p) noexcept {
+                const auto v = (juce::int32)((juce::uint32)p[0] | ((juce::uint32)p[1] << 8)
+                                             | ((juce::uint32)p[2] << 16) | ((juce::uint32)p[3] << 24));
+                return (float)((double)v * (1.0 / 2147483648.0));
+            }
+
+            static void write(juce::uint8* p, float value) noexcept {
+                const auto scaled = juce::jlimit(-2147483648.0, 2147483647.0, std::round((double)value * 2147483648.0));
+                const auto v = (juce::uint32)(juce::int32)scaled;
+                p[0] = (juce::uint8)v;
+                p[1] = (juce::uint8)(v >> 8);
+                p[2] = (juce::uint8)(v >> 16);
+                p[3] = (juce::uint8)(v >> 24);
+            }
+        };
+
+        /** Converts and de-interleaves in the same pass. */
+        template <SampleFormat format>
+        void readFrames(const juce::uint8* bytes, float* const* channels, int numChannels, int numFrames) noexcept {
+            const auto stride = getBytesPerSample(format) * numChannels;
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                const auto* p = bytes + ch * getBytesPerSample(format);
+                auto* out = channels[ch];
+
+                for (int n = 0; n < numFrames; ++n, p += stride)
+                    out[n] = Sample<format>::read(p);
+            }
+        }
+
+        /** Interleaves and converts in the same pass. */
+        template <SampleFormat format>
+        void writeFrames(const float* const* channels, juce::uint8* bytes, int numChannels, int numFrames) noexcept {
+            const auto stride = getBytesPerSample(format) * numChannels;
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto* p = bytes + ch * getBytesPerSample(format);
+                const auto* in = channels[ch];
+
+                for (int n = 0; n < numFrames; ++n, p += stride)
+                    Sample<format>::write(p, in[n]);
+            }
+        }
+
+        void readFrames(SampleFormat format, const juce::uint8* bytes, float* const* channels, int numChannels, int numFrames) noexcept {
+            switch (format) {
+                case SampleFormat::float32: readFrames<SampleFormat::float32>(bytes, channels, numChannels, numFrames); break;
+                case SampleFormat::int16:   readFrames<SampleFormat::int16>(bytes, channels, numChannels, numFrames); break;
+                case SampleFormat::int24:   readFrames<SampleFormat::int24>(bytes, channels, numChannels, numFrames); break;
+                case SampleFormat::int32:   readFrames<SampleFormat::int32>(bytes, channels, numChannels, numFrames); break;
+            }
+        }
+
+        void writeFrames(SampleFormat format, const float* const* channels, juce::uint8* bytes, int numChannels, int numFrames) noexcept {
+            switch (format) {
+                case SampleFormat::float32: writeFrames<SampleFormat::float32>(channels, bytes, numChannels, numFrames); break;
+                case SampleFormat::int16:   writeFrames<SampleFormat::int16>(channels, bytes, numChannels, numFrames); break;
+                case SampleFormat::int24:   writeFrames<SampleFormat::int24>(channels, bytes, numChannels, numFrames); break;
+                case SampleFormat::int32:   writeFrames<SampleFormat::int32>(channels, bytes, numChannels, numFrames); break;
+            }
+        }
+    }
+
+    //==============================================================================
+    bool parseSampleFormat(const juce::String& name, SampleFormat& format) {
+        if (name == "f32")      format = SampleFormat::float32;
+        else if (name == "s16") format = SampleFormat::int16;
+        else if (name == "s24") format = SampleFormat::int24;
+        else if (name == "s32") format = SampleFormat::int32;
+        else return false;
+
+        return true;
+    }
+
+    int getBytesPerSample(SampleFormat format) noexcept {
+        switch (format) {
+            case SampleFormat::float32: return 4;
+            case SampleFormat::int16:   return 2;
+            case SampleFormat::int24:   return 3;
+            case SampleFormat::int32:   return 4;
+        }
+        return 4;
+    }
+
+    juce::Result run(std::FILE* input, std::FILE* output, const Preset& preset,
+                     const OfflineRenderer::Settings& settings, const Options& options, Stats& stats) {
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        const auto numChannels = options.numChannels;
+        const auto blockSize = settings.blockSize;
+
+        auto processor = OfflineRenderer::createProcessor(preset, settings, options.sampleRate, numChannels);
+
+        const auto inputFrameSize = (size_t)(getBytesPerSample(options.inputFormat) * numChannels);
+        const auto outputFrameSize = (size_t)(getBytesPerSample(options.outputFormat) * numChannels);
+
+        // One buffer for both directions, big enough for the wider of the two formats.
+        juce::HeapBlock<juce::uint8> bytes(juce::jmax(inputFrameSize, outputFrameSize) * (size_t)blockSize);
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        stats = {};
+
+        for (;;) {
+            const auto numBytes = std::fread(bytes.get(), 1, inputFrameSize * (size_t)blockSize, input);
+            const auto numFrames = (int)(numBytes / inputFrameSize);
+
+            if (numFrames > 0) {
+                buffer.setSize(numChannels, numFrames, false, false, true);
+                readFrames(options.inputFormat, bytes.get(), buffer.getArrayOfWritePointers(), numChannels, numFrames);
+
+                processor->processBlock(buffer, midi);
+
+                writeFrames(options.outputFormat, buffer.getArrayOfReadPointers(), bytes.get(), numChannels, numFrames);
+                // Flushed every block, so the stage never holds back more than one block.
+                if (std::fwrite(bytes.get(), outputFrameSize, (size_t)numFrames, output) != (size_t)numFrames
+                    || std::fflush(output) != 0)
+                    return juce::Result::fail("Can't write the output stream");
+
+                stats.numFrames += numFrames;
+            }
+
+            // fread only comes back short at the end of the input (or on an error, which ends it too).
+            if (numBytes < inputFrameSize * (size_t)blockSize) {
+                stats.numBytesDropped = (int)(numBytes - (size_t)numFrames * inputFrameSize);
+                break;
+            }
+        }
+
+        stats.inputLoudness = processor->getInputLoudness();
+        stats.outputLoudness = processor->getOutputLoudness();
+
+        processor->releaseResources();
+
+        stats.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        return juce::Result::ok();
+    }
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    PcmPipe.h
+    Created: 19 Oct 2026
+
+    Raw interleaved PCM from one stream to another through the processor,
+    for use as a stage of a Unix pipeline (stdin to stdout by default). No
+    audio device, no file format: the caller states the sample rate,
+    channel count and sample format.
+
+    Each block is read into one byte buffer and converted straight into the
+    processor's planar float channels, and back into the byte buffer on the
+    way out; there are no other copies. The block size bounds both the
+    memory and the latency of the stage.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OfflineRenderer.h"
+
+namespace PcmPipe {
+
+    /** Little-endian, interleaved. */
+    enum class SampleFormat {
+        float32,
+        int16,
+        int24,      // packed, three bytes per sample
+        int32
+    };
+
+    /** "f32", "s16", "s24", "s32"; false if the name is none of these. */
+    bool parseSampleFormat(const juce::String& name, SampleFormat& format);
+
+    int getBytesPerSample(SampleFormat format) noexcept;
+
+    struct Options {
+        double sampleRate{ 48000.0 };
+        int numChannels{ 2 };
+        SampleFormat inputFormat{ SampleFormat::float32 };
+        SampleFormat outputFormat{ SampleFormat::float32 };
+    };
+
+    struct Stats {
+        juce::int64 numFrames{ 0 };
+        int numBytesDropped{ 0 };       // an incomplete frame at the end of the input
+        double seconds{ 0 };
+        LoudnessMeter::Reading inputLoudness, outputLoudness;
+    };
+
+    /** Runs until input ends. Returns an error if the output stream can't be written. */
+    juce::Result run(std::FILE* input, std::FILE* output, const Preset& preset,
+                     const OfflineRenderer::Settings& settings, const Options& options, Stats& stats);
+}
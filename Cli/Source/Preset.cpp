@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    Preset.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "Preset.h"
+#include "../../Source/AutomationTimeline.h"
+#include "../../Source/ParameterSnapshot.h"
+
+juce::Result Preset::load(const juce::File& file) {
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data))
+        return juce::Result::fail("Can't read preset " + file.getFullPathName());
+
+    if (ParameterSnapshot::isState(data.getData(), data.getSize())) {
+        state = std::move(data);
+        return juce::Result::ok();
+    }
+
+    // The same type the processor's APVTS uses, so both tree formats are checked against it.
+    const juce::Identifier expectedType("Parameters");
+    juce::ValueTree tree;
+
+    if (auto xml = juce::parseXML(data.toString())) {
+        tree = juce::ValueTree::fromXml(*xml);
+    }
+    else {
+        tree = juce::ValueTree::readFromData(data.getData(), data.getSize());
+    }
+
+    if (!tree.isValid() || !tree.hasType(expectedType))
+        return juce::Result::fail(file.getFileName() + " is neither a state blob nor an APVTS XML of this plugin");
+
+    // setStateInformation still reads the tree as older sessions saved it.
+    state.reset();
+    {
+        juce::MemoryOutputStream stream(state, false);
+        tree.writeToStream(stream);
+    }
+
+    return juce::Result::ok();
+}
+
+juce::Result Preset::addOverride(const juce::String& assignment) {
+    const auto name = assignment.upToFirstOccurrenceOf("=", false, false).trim();
+    const auto value = assignment.fromFirstOccurrenceOf("=", false, false).trim();
+
+    const auto& params = Params::GetParams();
+    const auto known = std::any_of(params.begin(), params.end(), [&name](auto& p) { return p.second == name; });
+
+    if (!known || value.isEmpty())
+        return juce::Result::fail("Unknown parameter or missing value in \"" + assignment + "\"");
+
+    overrides.push_back({ name, value.getFloatValue() });
+    return juce::Result::ok();
+}
+
+void Preset::applyTo(Multiband_compAudioProcessor& processor) const {
+    if (!state.isEmpty())
+        processor.setStateInformation(state.getData(), (int)state.getSize());
+
+    for (auto& o : overrides) {
+        auto* parameter = processor.apvts.getParameter(o.first);
+        parameter->setValueNotifyingHost(AutomationTimeline::toNormalised(*parameter, o.second));
+    }
+}
@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    Preset.h
+    Created: 19 Oct 2026
+
+    Parameter state for offline renders: either the blob written by
+    getStateInformation (e.g. dumped by a host, in the current format or
+    the older APVTS tree) or the APVTS as XML, plus single parameters
+    overridden by name from the command line.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class Multiband_compAudioProcessor;
+
+class Preset {
+public:
+    /** Reads a state blob or an APVTS XML file, whichever the file turns out to be. */
+    juce::Result load(const juce::File& file);
+
+    /** "Threshold Low Band=-18": a name from Params::GetParams() and a value in real units. */
+    juce::Result addOverride(const juce::String& assignment);
+
+    /** Applies the state, then the overrides. Call before prepareToPlay. */
+    void applyTo(Multiband_compAudioProcessor& processor) const;
+
+private:
+    juce::MemoryBlock state;    // as setStateInformation takes it
+    std::vector<std::pair<juce::String, float>> overrides;
+};
@@ -0,0 +1,328 @@
+/*
+  ==============================================================================
+
+    SweepRenderer.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SweepRenderer.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace {
+
+    constexpr int blocksPerBatch = 16;
+
+    double toDecibels(double gain) {
+        return juce::Decibels::gainToDecibels(gain, -200.0);
+    }
+
+    /** Runs fn(0) ... fn(numTasks - 1) on the pool and returns when all of them are done. */
+    void parallelFor(juce::ThreadPool& pool, int numTasks, const std::function<void(int)>& fn) {
+        if (numTasks <= 0)
+            return;
+
+        std::atomic<int> remaining{ numTasks };
+        juce::WaitableEvent allDone;
+
+        for (int i = 0; i < numTasks; ++i) {
+            pool.addJob([&, i] {
+                fn(i);
+                if (--remaining == 0)
+                    allDone.signal();
+            });
+        }
+
+        allDone.wait();
+    }
+
+    /** Variants that agree on these get the same bands out of the crossover. */
+    juce::String getSplitKey(Multiband_compAudioProcessor& processor) {
+        juce::String key;
+        for (auto name : { Params::Low_Mid_Crossover_Freq, Params::Mid_High_Crossover_Freq, Params::Gain_In })
+            key << juce::String(processor.apvts.getRawParameterValue(Params::GetParams().at(name))->load(), 6) << ";";
+        return key;
+    }
+
+    struct Splitter {
+        std::unique_ptr<Multiband_compAudioProcessor> processor;
+        juce::AudioBuffer<float> scratch;
+
+        // Two batches of bands, one being split while the variants read the other.
+        // [slot][band][channel] rows of a whole batch each.
+        juce::HeapBlock<float> bands[2];
+    };
+
+    struct VariantState {
+        std::unique_ptr<Multiband_compAudioProcessor> processor;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        juce::AudioBuffer<float> output;
+        int splitter{ 0 };
+
+        float peak{ 0 };
+        double energy{ 0 };
+        std::unique_ptr<LoudnessMeter> loudness;
+        bool writeFailed{ false };
+    };
+}
+
+//==============================================================================
+juce::Result SweepRenderer::makeGrid(const Preset& base, const juce::StringArray& axes, std::vector<Variant>& variants) {
+    variants = { { {}, base } };
+
+    for (auto& axis : axes) {
+        const auto name = axis.upToFirstOccurrenceOf("=", false, false).trim();
+        const auto values = juce::StringArray::fromTokens(axis.fromFirstOccurrenceOf("=", false, false), ",", "\"");
+
+        if (values.isEmpty())
+            return juce::Result::fail("No values in \"" + axis + "\"");
+
+        std::vector<Variant> grid;
+
+        for (auto& variant : variants) {
+            for (auto& value : values) {
+                const auto assignment = name + "=" + value.trim();
+
+                Variant v{ variant.label.isEmpty() ? assignment : variant.label + "; " + assignment, variant.preset };
+                const auto result = v.preset.addOverride(assignment);
+                if (result.failed())
+                    return result;
+
+                grid.push_back(std::move(v));
+            }
+        }
+
+        variants = std::move(grid);
+    }
+
+    return juce::Result::ok();
+}
+
+//==============================================================================
+SweepRenderer::SweepRenderer(const OfflineRenderer::Settings& s, int threads)
+    : settings(s), numThreads(threads > 0 ? threads : juce::SystemStats::getNumCpus()) {}
+
+juce::Result SweepRenderer::render(const juce::File& input, const juce::File& outputDirectory,
+                                   const std::vector<Variant>& variants, Report& report) {
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    OfflineRenderer::AudioFiles files;
+    auto reader = files.openReader(input);
+    if (reader == nullptr)
+        return juce::Result::fail("Can't read " + input.getFullPathName());
+
+    const auto numChannels = (int)reader->numChannels;
+    const auto sampleRate = reader->sampleRate;
+    const auto length = reader->lengthInSamples;
+    const auto blockSize = settings.blockSize;
+    const auto batchLength = blockSize * blocksPerBatch;
+
+    if (numChannels < 1 || numChannels > 2)
+        return juce::Result::fail(input.getFileName() + ": only mono and stereo files are supported");
+
+    const auto extension = settings.outputFormat.isNotEmpty() ? "." + settings.outputFormat : input.getFileExtension();
+
+    std::vector<Splitter> splitters;
+    std::vector<VariantState> states(variants.size());
+    juce::StringArray splitKeys;
+
+    report = {};
+
+    for (size_t v = 0; v < variants.size(); ++v) {
+        auto& state = states[v];
+        state.processor = OfflineRenderer::createProcessor(variants[v].preset, settings, sampleRate, numChannels);
+
+        // processFromBands skips the processor's own meters.
+        state.loudness = std::make_unique<LoudnessMeter>();
+        state.loudness->prepare(sampleRate);
+        state.output.setSize(numChannels, blockSize);
+
+        const auto key = getSplitKey(*state.processor);
+        state.splitter = splitKeys.indexOf(key);
+
+        if (state.splitter < 0) {
+            state.splitter = splitKeys.size();
+            splitKeys.add(key);
+
+            Splitter splitter;
+            splitter.processor = OfflineRenderer::createProcessor(variants[v].preset, settings, sampleRate, numChannels);
+            splitter.scratch.setSize(numChannels, blockSize);
+            for (auto& b : splitter.bands)
+                b.allocate((size_t)(DspStateArena::numBands * numChannels * batchLength), true);
+            splitters.push_back(std::move(splitter));
+        }
+
+        VariantStats stats;
+        stats.output = outputDirectory.getChildFile(input.getFileNameWithoutExtension() + "_sweep_"
+                                                    + juce::String((int)v + 1).paddedLeft('0', 3) + extension);
+
+        state.writer = files.createWriter(stats.output, sampleRate, numChannels, (int)reader->bitsPerSample,
+                                          reader->metadataValues, settings);
+        if (state.writer == nullptr)
+            return juce::Result::fail("Can't write " + stats.output.getFullPathName());
+
+        report.variants.push_back(stats);
+    }
+
+    report.numSplitters = (int)splitters.size();
+
+    // Where block `block` of band/channel sits in a splitter's batch.
+    auto getBands = [&](Splitter& splitter, int slot, int block, float** bands) {
+        for (int i = 0; i < DspStateArena::numBands * numChannels; ++i)
+            bands[i] = splitter.bands[slot].get() + (size_t)i * (size_t)batchLength + (size_t)(block * blockSize);
+    };
+
+    juce::AudioBuffer<float> inputBatch[2]{ juce::AudioBuffer<float>(numChannels, batchLength),
+                                           juce::AudioBuffer<float>(numChannels, batchLength) };
+    int batchSize[2] = { 0, 0 };
+    double inputEnergy = 0;
+
+    auto readBatch = [&](juce::int64 position, int slot) {
+        batchSize[slot] = (int)juce::jmin((juce::int64)batchLength, length - position);
+        reader->read(&inputBatch[slot], 0, batchSize[slot], position, true, true);
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto* x = inputBatch[slot].getReadPointer(ch);
+            for (int n = 0; n < batchSize[slot]; ++n)
+                inputEnergy += (double)x[n] * x[n];
+        }
+    };
+
+    auto split = [&](Splitter& splitter, int slot) {
+        float* bands[DspStateArena::numBands * 2];
+
+        for (int block = 0, done = 0; done < batchSize[slot]; ++block, done += blockSize) {
+            const auto numSamples = juce::jmin(blockSize, batchSize[slot] - done);
+            splitter.scratch.setSize(numChannels, numSamples, false, false, true);
+            for (int ch = 0; ch < numChannels; ++ch)
+                splitter.scratch.copyFrom(ch, 0, inputBatch[slot], ch, done, numSamples);
+
+            getBands(splitter, slot, block, bands);
+            splitter.processor->processUpToBands(splitter.scratch, bands);
+        }
+    };
+
+    auto compress = [&](VariantState& state, int slot) {
+        float* bands[DspStateArena::numBands * 2];
+
+        for (int block = 0, done = 0; done < batchSize[slot]; ++block, done += blockSize) {
+            const auto numSamples = juce::jmin(blockSize, batchSize[slot] - done);
+            state.output.setSize(numChannels, numSamples, false, false, true);
+
+            getBands(splitters[(size_t)state.splitter], slot, block, bands);
+            state.processor->processFromBands(bands, state.output);
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                const auto* y = state.output.getReadPointer(ch);
+                for (int n = 0; n < numSamples; ++n) {
+                    state.peak = juce::jmax(state.peak, std::abs(y[n]));
+                    state.energy += (double)y[n] * y[n];
+                }
+            }
+
+            state.loudness->process(state.output.getArrayOfReadPointers(), numChannels, numSamples);
+
+            if (!state.writer->writeFromAudioSampleBuffer(state.output, 0, numSamples))
+                state.writeFailed = true;
+        }
+    };
+
+    juce::ThreadPool pool(numThreads);
+
+    const auto numSplitters = (int)splitters.size();
+    const auto numVariants = (int)states.size();
+
+    if (length > 0) {
+        readBatch(0, 0);
+        parallelFor(pool, numSplitters, [&](int s) { split(splitters[(size_t)s], 0); });
+    }
+
+    for (juce::int64 position = 0; position < length; position += batchLength) {
+        const auto slot = (int)((position / batchLength) & 1);
+        const auto nextPosition = position + batchLength;
+        const auto hasNext = nextPosition < length;
+
+        if (hasNext)
+            readBatch(nextPosition, slot ^ 1);
+
+        // The variants compress this batch while the splitters split the next one.
+        parallelFor(pool, numVariants + (hasNext ? numSplitters : 0), [&](int task) {
+            if (task < numVariants)
+                compress(states[(size_t)task], slot);
+            else
+                split(splitters[(size_t)(task - numVariants)], slot ^ 1);
+        });
+    }
+
+    const auto numValues = juce::jmax(1.0, (double)length * numChannels);
+    const auto inputRms = std::sqrt(inputEnergy / numValues);
+
+    for (size_t v = 0; v < states.size(); ++v) {
+        auto& state = states[v];
+        auto& stats = report.variants[v];
+
+        if (state.writeFailed)
+            return juce::Result::fail("Write error on " + stats.output.getFullPathName());
+
+        state.writer.reset();
+
+        const auto rms = std::sqrt(state.energy / numValues);
+        stats.peakDb = toDecibels(state.peak);
+        stats.rmsDb = toDecibels(rms);
+        stats.crestDb = stats.peakDb - stats.rmsDb;
+        stats.levelChangeDb = stats.rmsDb - toDecibels(inputRms);
+        stats.loudness = state.loudness->getReading();
+    }
+
+    report.stats.numSamples = length;
+    report.stats.sampleRate = sampleRate;
+    report.stats.numChannels = numChannels;
+    report.stats.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    return juce::Result::ok();
+}
+
+//==============================================================================
+juce::String SweepRenderer::formatReport(const std::vector<Variant>& variants, const Report& report) {
+    juce::String text;
+
+    auto column = [](const juce::String& s, int width) { return s.paddedRight(' ', width); };
+
+    text << column("#", 6) << column("peak dB", 10) << column("rms dB", 10) << column("crest dB", 10)
+         << column("change dB", 11) << column("LUFS", 8) << column("dBTP", 8) << "settings" << juce::newLine;
+
+    for (size_t v = 0; v < variants.size(); ++v) {
+        const auto& s = report.variants[v];
+        text << column(juce::String((int)v + 1), 6)
+             << column(juce::String(s.peakDb, 2), 10) << column(juce::String(s.rmsDb, 2), 10)
+             << column(juce::String(s.crestDb, 2), 10) << column(juce::String(s.levelChangeDb, 2), 11)
+             << column(LoudnessMeter::toString(s.loudness.integrated), 8) << column(LoudnessMeter::toString(s.loudness.truePeak), 8)
+             << (variants[v].label.isEmpty() ? juce::String("(preset)") : variants[v].label) << juce::newLine;
+    }
+
+    const auto audioSeconds = (double)report.stats.numSamples / report.stats.sampleRate * (double)variants.size();
+
+    text << juce::newLine << variants.size() << " variants, " << report.numSplitters << " crossover split"
+         << (report.numSplitters == 1 ? "" : "s") << ", " << juce::String(report.stats.seconds, 2) << " s ("
+         << juce::String(report.stats.seconds > 0 ? audioSeconds / report.stats.seconds : 0.0, 1)
+         << "x realtime over all variants)" << juce::newLine;
+
+    return text;
+}
+
+juce::String SweepRenderer::toCsv(const std::vector<Variant>& variants, const Report& report) {
+    juce::String csv;
+    csv << "variant,file,peak_db,rms_db,crest_db,level_change_db,integrated_lufs,true_peak_dbtp,settings" << juce::newLine;
+
+    for (size_t v = 0; v < variants.size(); ++v) {
+        const auto& s = report.variants[v];
+        csv << (int)v + 1 << "," << s.output.getFileName() << ","
+            << juce::String(s.peakDb, 3) << "," << juce::String(s.rmsDb, 3) << ","
+            << juce::String(s.crestDb, 3) << "," << juce::String(s.levelChangeDb, 3) << ","
+            << juce::String(s.loudness.integrated, 2) << "," << juce::String(s.loudness.truePeak, 2) << ","
+            << variants[v].label.quoted() << juce::newLine;
+    }
+
+    return csv;
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    SweepRenderer.h
+    Created: 19 Oct 2026
+
+    Renders one file with many settings at once, for preset tuning. The
+    crossover output only depends on the crossover frequencies and the input
+    gain, so variants that agree on those share one splitting processor:
+    it splits each block into bands once (processUpToBands) and every
+    variant's processor compresses and sums its own copy of them
+    (processFromBands).
+
+    The input goes through in batches of blocks. While the variants work on
+    one batch, the splitters already split the next, all on the same pool.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "OfflineRenderer.h"
+
+class SweepRenderer {
+public:
+    struct Variant {
+        juce::String label;     // its overrides, "Threshold Low Band=-24; Ratio Low Band=4"
+        Preset preset;
+    };
+
+    /** Every combination of the axes' values on top of base. An axis is "Name=value,value,...". */
+    static juce::Result makeGrid(const Preset& base, const juce::StringArray& axes, std::vector<Variant>& variants);
+
+    struct VariantStats {
+        juce::File output;
+        double peakDb{ 0 };
+        double rmsDb{ 0 };
+        double crestDb{ 0 };
+        double levelChangeDb{ 0 };  // output RMS against input RMS
+        LoudnessMeter::Reading loudness;
+    };
+
+    struct Report {
+        OfflineRenderer::Stats stats;
+        int numSplitters{ 0 };
+        std::vector<VariantStats> variants;
+    };
+
+    /** numThreads <= 0 uses every core. */
+    SweepRenderer(const OfflineRenderer::Settings& settings, int numThreads = 0);
+
+    /** Writes <input name>_sweep_<n> for each variant into outputDirectory. */
+    juce::Result render(const juce::File& input, const juce::File& outputDirectory,
+                        const std::vector<Variant>& variants, Report& report);
+
+    static juce::String formatReport(const std::vector<Variant>& variants, const Report& report);
+    static juce::String toCsv(const std::vector<Variant>& variants, const Report& report);
+
+private:
+    const OfflineRenderer::Settings settings;
+    const int numThreads;
+};
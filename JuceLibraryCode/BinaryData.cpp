@@ -116,6 +116,30 @@ static const unsigned char temp_binary_data_0[] =
 "              caption-placement=\"centred-bottom\" slider-type=\"rotary\" pos-width=\"0.5\"\r\n"
 "              caption=\"GAIN-OUT\" caption-color=\"FF3900FF\" height=\"200\" width=\"1\"/>\r\n"
 "    </View>\r\n"
+"    <View caption=\"ANALYSER\" border=\"1\" height=\"180\" flex-grow=\"0\">\r\n"
+"      <Analyser flex-grow=\"1\" caption-size=\"0\"/>\r\n"
+"    </View>\r\n"
+"    <View caption=\"METERS\" border=\"1\" height=\"130\" flex-grow=\"0\">\r\n"
+"      <Meter source=\"input\" caption=\"in\" caption-size=\"14\" max-width=\"50\"/>\r\n"
+"      <Meter source=\"band-input\" caption=\"bands in\" caption-size=\"14\" max-width=\"70\"/>\r\n"
+"      <View class=\"plot-view\" caption=\"gain reduction\" flex-grow=\"1\">\r\n"
+"        <Plot source=\"gr-low\" plot-color=\"FF8EB12E\" plot-fill-color=\"408EB12E\"/>\r\n"
+"        <Plot source=\"gr-mid\" plot-color=\"FFE0A030\" plot-fill-color=\"40E0A030\"/>\r\n"
+"        <Plot source=\"gr-high\" plot-color=\"FF30A0E0\" plot-fill-color=\"4030A0E0\"/>\r\n"
+"      </View>\r\n"
+"      <Meter source=\"band-output\" caption=\"bands out\" caption-size=\"14\" max-width=\"70\"/>\r\n"
+"      <Meter source=\"output\" caption=\"out\" caption-size=\"14\" max-width=\"50\"/>\r\n"
+"    </View>\r\n"
+"    <View caption=\"LOUDNESS\" border=\"1\" height=\"70\" flex-grow=\"0\">\r\n"
+"      <Loudness flex-grow=\"1\" caption-size=\"0\"/>\r\n"
+"    </View>\r\n"
+"    <View caption=\"PERFORMANCE\" border=\"1\" height=\"60\" flex-grow=\"0\">\r\n"
+"      <Performance flex-grow=\"1\" caption-size=\"0\"/>\r\n"
+"    </View>\r\n"
+"    <View caption=\"DIAGNOSTICS\" visibility=\"diagnostics:visible\" border=\"1\"\r\n"
+"          height=\"170\" flex-grow=\"0\">\r\n"
+"      <StageProfiler flex-grow=\"1\" caption-size=\"0\"/>\r\n"
+"    </View>\r\n"
 "  </View>\r\n"
 "</magic>\r\n"
 "\0";
@@ -250,7 +274,7 @@ const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)
 
     switch (hash)
     {
-        case 0x910f5130:  numBytes = 6931; return final_upam;
+        case 0x910f5130:  numBytes = 8262; return final_upam;
         case 0x1503bd23:  numBytes = 6954; return test_velikost_fixpozicije;
         default: break;
     }
@@ -9,7 +9,7 @@
 namespace BinaryData
 {
     extern const char*   final_upam;
-    const int            final_upamSize = 6931;
+    const int            final_upamSize = 8262;
 
     extern const char*   test_velikost_fixpozicije;
     const int            test_velikost_fixpozicijeSize = 6954;
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    AnalyserPanel.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AnalyserPanel.h"
+#include "PluginProcessor.h"
+
+namespace {
+    constexpr float topDecibels = 0.0f;
+    constexpr float bottomDecibels = -84.0f;
+}
+
+//==============================================================================
+AnalyserView::AnalyserView(Multiband_compAudioProcessor* processorToShow)
+    : LiveView(SpectrumAnalyser::maxFramesPerSecond), processor(processorToShow) {
+
+    for (auto& spectrum : spectra)
+        spectrum.fill(SpectrumAnalyser::minDecibels);
+
+    if (processor == nullptr)
+        return;
+
+    const auto& names = Params::GetParams();
+    crossoverValues[0] = processor->apvts.getRawParameterValue(names.at(Params::Low_Mid_Crossover_Freq));
+    crossoverValues[1] = processor->apvts.getRawParameterValue(names.at(Params::Mid_High_Crossover_Freq));
+
+    // Polling is cheap; a repaint only follows a new frame.
+    startRefreshing();
+}
+
+AnalyserView::~AnalyserView() {
+    if (isViewer)
+        processor->getAnalyser().removeViewer();
+}
+
+void AnalyserView::showingChanged(bool isNowShowing) {
+    // The worker (and the audio thread's copying) only runs while the spectrum is on screen.
+    if (isNowShowing)
+        processor->getAnalyser().addViewer();
+    else
+        processor->getAnalyser().removeViewer();
+
+    isViewer = isNowShowing;
+}
+
+void AnalyserView::refresh() {
+    auto& analyser = processor->getAnalyser();
+
+    const auto newFrameNumber = analyser.getFrameNumber();
+    const auto newLowMid = crossoverValues[0]->load();
+    const auto newMidHigh = crossoverValues[1]->load();
+
+    if (newFrameNumber == frameNumber && newLowMid == crossovers[0] && newMidHigh == crossovers[1])
+        return;
+
+    if (newFrameNumber != frameNumber) {
+        frameNumber = newFrameNumber;
+        for (int stream = 0; stream < SpectrumAnalyser::numStreams; ++stream)
+            analyser.getSpectrum((SpectrumAnalyser::Stream)stream, spectra[stream]);
+    }
+
+    crossovers[0] = newLowMid;
+    crossovers[1] = newMidHigh;
+    repaint();
+}
+
+float AnalyserView::getX(float frequency) const noexcept {
+    return juce::jmap(SpectrumAnalyser::getPointForFrequency(frequency), 0.0f, (float)(SpectrumAnalyser::numPoints - 1),
+                      0.0f, (float)getWidth());
+}
+
+juce::Path AnalyserView::createPath(const SpectrumAnalyser::Spectrum& spectrum, bool closed) const {
+    const auto width = (float)getWidth();
+    const auto height = (float)getHeight();
+
+    juce::Path path;
+    path.preallocateSpace(SpectrumAnalyser::numPoints * 3 + 8);
+
+    for (int p = 0; p < SpectrumAnalyser::numPoints; ++p) {
+        const auto x = juce::jmap((float)p, 0.0f, (float)(SpectrumAnalyser::numPoints - 1), 0.0f, width);
+        const auto y = juce::jmap(juce::jlimit(bottomDecibels, topDecibels, spectrum[(size_t)p]),
+                                  topDecibels, bottomDecibels, 0.0f, height);
+        if (p == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+
+    if (closed) {
+        path.lineTo(width, height);
+        path.lineTo(0.0f, height);
+        path.closeSubPath();
+    }
+
+    return path;
+}
+
+void AnalyserView::paint(juce::Graphics& g) {
+    g.setFont(11.0f);
+
+    // Decades, and a line every 12 dB.
+    g.setColour(juce::Colours::white.withAlpha(0.1f));
+    for (auto frequency : { 100.0f, 1000.0f, 10000.0f })
+        g.drawVerticalLine(juce::roundToInt(getX(frequency)), 0.0f, (float)getHeight());
+    for (auto decibels = topDecibels - 12.0f; decibels > bottomDecibels; decibels -= 12.0f)
+        g.drawHorizontalLine(juce::roundToInt(juce::jmap(decibels, topDecibels, bottomDecibels, 0.0f, (float)getHeight())),
+                             0.0f, (float)getWidth());
+
+    if (processor == nullptr)
+        return;
+
+    // Input filled underneath, output as a line on top, so the difference is what the compressor did.
+    g.setColour(juce::Colours::grey.withAlpha(0.35f));
+    g.fillPath(createPath(spectra[SpectrumAnalyser::input], true));
+
+    g.setColour(juce::Colour(0xFF8EB12E));
+    g.strokePath(createPath(spectra[SpectrumAnalyser::output], false), juce::PathStrokeType(1.5f));
+
+    g.setColour(juce::Colours::orange);
+    for (auto frequency : crossovers) {
+        const auto x = getX(frequency);
+        g.drawVerticalLine(juce::roundToInt(x), 0.0f, (float)getHeight());
+        g.drawText(juce::String(juce::roundToInt(frequency)) + " Hz",
+                   juce::Rectangle<float>(x + 3.0f, 2.0f, 70.0f, 14.0f), juce::Justification::centredLeft);
+    }
+}
+
+//==============================================================================
+AnalyserPanel::AnalyserPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node)
+    : foleys::GuiItem(builder, node),
+      view(dynamic_cast<Multiband_compAudioProcessor*>(builder.getMagicState().getProcessor())) {
+
+    addAndMakeVisible(view);
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    AnalyserPanel.h
+    Created: 19 Oct 2026
+
+    Spectrum analyser of the editor: input and output spectrum from the
+    processor's SpectrumAnalyser, with the two crossover frequencies marked.
+    Registered with the foleys builder as <Analyser/>. The analyser only
+    runs while a view is on screen, and the view only repaints when the
+    worker has published a new frame or a crossover has moved.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LiveView.h"
+#include "SpectrumAnalyser.h"
+
+class Multiband_compAudioProcessor;
+
+class AnalyserView : public LiveView {
+public:
+    explicit AnalyserView(Multiband_compAudioProcessor* processorToShow);
+    ~AnalyserView() override;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    void refresh() override;
+    void showingChanged(bool isNowShowing) override;
+
+    float getX(float frequency) const noexcept;
+    juce::Path createPath(const SpectrumAnalyser::Spectrum& spectrum, bool closed) const;
+
+    Multiband_compAudioProcessor* processor;
+    std::atomic<float>* crossoverValues[2]{};
+
+    juce::uint32 frameNumber{ 0 };
+    SpectrumAnalyser::Spectrum spectra[SpectrumAnalyser::numStreams];
+    float crossovers[2]{};
+    bool isViewer{ false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyserView)
+};
+
+class AnalyserPanel : public foleys::GuiItem {
+public:
+    FOLEYS_DECLARE_GUI_FACTORY(AnalyserPanel)
+
+    AnalyserPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node);
+
+    void update() override {}
+    juce::Component* getWrappedComponent() override { return &view; }
+
+private:
+    AnalyserView view;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyserPanel)
+};
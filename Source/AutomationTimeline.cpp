@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    AutomationTimeline.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AutomationTimeline.h"
+
+juce::Result AutomationTimeline::load(const juce::File& file, juce::AudioProcessorValueTreeState& apvts) {
+    const auto text = file.loadFileAsString();
+    if (text.isEmpty())
+        return juce::Result::fail("Can't read automation " + file.getFullPathName());
+
+    points.clear();
+
+    const auto first = text.trimStart()[0];
+    const auto result = first == '[' || first == '{' ? loadJson(juce::JSON::parse(text), apvts)
+                                                     : loadCsv(text, apvts);
+    if (result.failed())
+        return juce::Result::fail(file.getFileName() + ": " + result.getErrorMessage());
+
+    std::stable_sort(points.begin(), points.end(), [](const Point& a, const Point& b) { return a.sample < b.sample; });
+    return juce::Result::ok();
+}
+
+juce::Result AutomationTimeline::addPoint(const juce::String& parameterName, juce::int64 sample, float value,
+                                          juce::AudioProcessorValueTreeState& apvts) {
+    for (auto& p : Params::GetParams()) {
+        if (p.second != parameterName)
+            continue;
+
+        if (sample < 0)
+            return juce::Result::fail("Negative sample position for " + parameterName);
+
+        points.push_back({ sample, p.first, toNormalised(*apvts.getParameter(p.second), value) });
+        return juce::Result::ok();
+    }
+
+    return juce::Result::fail("Unknown parameter \"" + parameterName + "\"");
+}
+
+juce::Result AutomationTimeline::loadCsv(const juce::String& text, juce::AudioProcessorValueTreeState& apvts) {
+    auto lines = juce::StringArray::fromLines(text);
+    auto seenFirstLine = false;     // comments and blank lines don't count
+
+    for (int i = 0; i < lines.size(); ++i) {
+        const auto line = lines[i].trim();
+        if (line.isEmpty() || line.startsWithChar('#'))
+            continue;
+
+        const auto fields = juce::StringArray::fromTokens(line, ",", "\"");
+        if (fields.size() != 3)
+            return juce::Result::fail("line " + juce::String(i + 1) + ": expected parameter,sample,value");
+
+        // A header line, if there is one.
+        const auto isFirstLine = !std::exchange(seenFirstLine, true);
+        if (isFirstLine && !fields[1].trim().containsOnly("0123456789"))
+            continue;
+
+        const auto result = addPoint(fields[0].trim().unquoted(), fields[1].trim().getLargeIntValue(),
+                                     fields[2].trim().getFloatValue(), apvts);
+        if (result.failed())
+            return juce::Result::fail("line " + juce::String(i + 1) + ": " + result.getErrorMessage());
+    }
+
+    return juce::Result::ok();
+}
+
+juce::Result AutomationTimeline::loadJson(const juce::var& json, juce::AudioProcessorValueTreeState& apvts) {
+    const auto* array = json.getArray();
+    if (array == nullptr)
+        return juce::Result::fail("expected an array of { parameter, sample, value } objects");
+
+    for (auto& point : *array) {
+        if (!point.hasProperty("parameter") || !point.hasProperty("sample") || !point.hasProperty("value"))
+            return juce::Result::fail("every point needs parameter, sample and value");
+
+        const auto result = addPoint(point["parameter"].toString(), (juce::int64)point["sample"],
+                                     (float)point["value"], apvts);
+        if (result.failed())
+            return result;
+    }
+
+    return juce::Result::ok();
+}
+
+float AutomationTimeline::toNormalised(juce::RangedAudioParameter& parameter, float value) {
+    // Ratios are given as the ratio, not as the index of the choice.
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(&parameter)) {
+        auto best = 0;
+        for (int i = 1; i < choice->choices.size(); ++i) {
+            if (std::abs(choice->choices[i].getFloatValue() - value) < std::abs(choice->choices[best].getFloatValue() - value))
+                best = i;
+        }
+        value = (float)best;
+    }
+
+    return parameter.convertTo0to1(value);
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    AutomationTimeline.h
+    Created: 19 Oct 2026
+
+    Parameter automation for offline renders, read from a file and replayed
+    by the processor at the exact sample of each point (see
+    Multiband_compAudioProcessor::setAutomation). Host blocks stay as large
+    as the renderer likes: the processor splits them at the points itself.
+
+    A point sets a parameter from its sample on, like a host's automation
+    event; a ramp is given as a run of points. Names are the ones in
+    Params::GetParams(), values are in real units (dB, ms, Hz, the ratio,
+    0/1 for the switches).
+
+    CSV:   parameter,sample,value        (one point per line, header optional,
+                                          after any # comments and blank lines)
+    JSON:  [ { "parameter": "Gain Out", "sample": 48000, "value": -3 }, ... ]
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+
+class AutomationTimeline {
+public:
+    struct Point {
+        juce::int64 sample;
+        Params::Names parameter;
+        float normalisedValue;
+    };
+
+    /** CSV or JSON, told apart by the first character. apvts converts the values to 0..1. */
+    juce::Result load(const juce::File& file, juce::AudioProcessorValueTreeState& apvts);
+
+    juce::Result addPoint(const juce::String& parameterName, juce::int64 sample, float value,
+                          juce::AudioProcessorValueTreeState& apvts);
+
+    /** Points in the order they are played, points at the same sample in the order they were added. */
+    const std::vector<Point>& getPoints() const noexcept { return points; }
+
+    bool isEmpty() const noexcept { return points.empty(); }
+
+    /** A value in real units as the parameter's 0..1 value; choices pick the choice nearest to the value. */
+    static float toNormalised(juce::RangedAudioParameter& parameter, float value);
+
+private:
+    juce::Result loadCsv(const juce::String& text, juce::AudioProcessorValueTreeState& apvts);
+    juce::Result loadJson(const juce::var& json, juce::AudioProcessorValueTreeState& apvts);
+
+    std::vector<Point> points;
+};
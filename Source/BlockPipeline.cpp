@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    BlockPipeline.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BlockPipeline.h"
+#include "RealtimeGuard.h"
+
+#include <thread>
+
+class BlockPipeline::Worker : public juce::Thread {
+public:
+    explicit Worker(BlockPipeline& p) : juce::Thread("BlockPipeline"), pipeline(p) {}
+
+    void run() override {
+        const RealtimeGuard::ScopedAudioThread rtGuard;
+        juce::ScopedNoDenormals noDenormals;
+
+        while (!threadShouldExit()) {
+            pipeline.wake.wait(100);
+            pipeline.tryProcessPending();
+        }
+    }
+
+private:
+    BlockPipeline& pipeline;
+};
+
+//==============================================================================
+BlockPipeline::BlockPipeline() = default;
+
+BlockPipeline::~BlockPipeline() {
+    stop();
+}
+
+void BlockPipeline::start(int numChannels, int maxBlockSize, ProcessFunction processToUse) {
+    stop();
+
+    process = std::move(processToUse);
+    latency = maxBlockSize;
+    samplesToDiscard = 0;
+    numUnderruns = 0;
+
+    // Room for a few blocks, so a briefly late worker doesn't make the host wait or drop.
+    // A restart with the same or a smaller block size keeps the storage it has.
+    const auto capacity = 4 * maxBlockSize + 1;
+    if (inputFifo == nullptr) {
+        inputFifo = std::make_unique<juce::AbstractFifo>(capacity);
+        outputFifo = std::make_unique<juce::AbstractFifo>(capacity);
+    } else {
+        inputFifo->setTotalSize(capacity);
+        outputFifo->setTotalSize(capacity);
+    }
+    inputStorage.setSize(numChannels, capacity, false, false, true);
+    outputStorage.setSize(numChannels, capacity, false, false, true);
+    workBuffer.setSize(numChannels, maxBlockSize, false, false, true);
+
+    // The latency: one block of silence ahead of the first processed sample.
+    outputStorage.clear();
+    outputFifo->finishedWrite(latency);
+
+    worker = std::make_unique<Worker>(*this);
+    worker->startThread(10);
+}
+
+void BlockPipeline::stop() {
+    if (worker == nullptr)
+        return;
+
+    worker->signalThreadShouldExit();
+    wake.signal();
+    worker->stopThread(2000);
+    worker.reset();
+}
+
+//==============================================================================
+void BlockPipeline::exchange(float* const* channels, int numChannels, int numSamples, bool catchUp) noexcept {
+    jassert(numSamples <= latency && numChannels <= inputStorage.getNumChannels());
+
+    if (inputFifo->getFreeSpace() < numSamples) {
+        // The worker is several blocks behind: skip this block on both sides, which keeps
+        // the input and output FIFOs in step.
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::clear(channels[ch], numSamples);
+        numUnderruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    write(*inputFifo, inputStorage, channels, numChannels, numSamples);
+    wake.signal();
+
+    if (catchUp) {
+        // The worker is at most one slice into this call's input, wait for it rather than for a whole period.
+        while (outputFifo->getNumReady() < samplesToDiscard + numSamples
+               && (inputFifo->getNumReady() > 0 || processing.load(std::memory_order_acquire)))
+            if (!tryProcessPending())
+                std::this_thread::yield();
+    }
+
+    // Samples that came too late for an earlier block.
+    while (samplesToDiscard > 0 && outputFifo->getNumReady() > 0) {
+        const auto n = juce::jmin(samplesToDiscard, outputFifo->getNumReady());
+        outputFifo->finishedRead(n);
+        samplesToDiscard -= n;
+    }
+
+    // Late: the worker had a whole period for this block, waiting longer would only eat into the host's.
+    if (samplesToDiscard > 0 || outputFifo->getNumReady() < numSamples) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::clear(channels[ch], numSamples);
+        samplesToDiscard += numSamples;
+        numUnderruns.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    read(*outputFifo, outputStorage, channels, numChannels, numSamples);
+}
+
+bool BlockPipeline::tryProcessPending() noexcept {
+    if (processing.exchange(true, std::memory_order_acquire))
+        return false;
+
+    processPending();
+    processing.store(false, std::memory_order_release);
+    return true;
+}
+
+void BlockPipeline::processPending() noexcept {
+    const auto numChannels = workBuffer.getNumChannels();
+
+    for (;;) {
+        const auto numSamples = juce::jmin(inputFifo->getNumReady(), latency);
+        if (numSamples == 0 || outputFifo->getFreeSpace() < numSamples)
+            return;
+
+        float* const* channels = workBuffer.getArrayOfWritePointers();
+        read(*inputFifo, inputStorage, channels, numChannels, numSamples);
+        process(channels, numChannels, numSamples);
+        write(*outputFifo, outputStorage, channels, numChannels, numSamples);
+    }
+}
+
+//==============================================================================
+void BlockPipeline::write(juce::AbstractFifo& fifo, juce::AudioBuffer<float>& storage,
+                          const float* const* channels, int numChannels, int numSamples) noexcept {
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        storage.copyFrom(ch, start1, channels[ch], size1);
+        if (size2 > 0)
+            storage.copyFrom(ch, start2, channels[ch] + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+void BlockPipeline::read(juce::AbstractFifo& fifo, juce::AudioBuffer<float>& storage,
+                         float* const* channels, int numChannels, int numSamples) noexcept {
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        juce::FloatVectorOperations::copy(channels[ch], storage.getReadPointer(ch, start1), size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(channels[ch] + size1, storage.getReadPointer(ch, start2), size2);
+    }
+
+    fifo.finishedRead(size1 + size2);
+}
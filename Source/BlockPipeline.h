@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    BlockPipeline.h
+    Created: 19 Oct 2026
+
+    Opt-in pipelined mode (Multiband_compAudioProcessor::setPipelined): the
+    host's audio thread only copies samples into one wait-free SPSC FIFO
+    and out of another, and a worker thread of our own runs the chain in
+    between. The output FIFO starts with one prepared block of silence, so
+    the latency is exactly that many samples whatever block sizes the host
+    sends, and the worker has a whole host period to process each block
+    while the host runs its other plugins.
+
+    The host thread wakes the worker through a counting semaphore, which
+    doesn't take a lock. If the worker hasn't delivered by the time the host
+    needs the samples, the host doesn't wait: it outputs silence, counts an
+    underrun and drops the late samples when they arrive, so the latency
+    never drifts.
+
+    A host block longer than the latency is exchanged in slices. From the
+    second slice on, the output is due for input that arrived in the same
+    call, so no worker could have delivered it: those slices catch up on the
+    host thread instead, taking over from the worker once it has finished
+    the slice it is on. Whoever processes holds an atomic flag, never a lock.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "WakeSemaphore.h"
+
+class BlockPipeline {
+public:
+    /** Runs on the worker: process numSamples <= the prepared block size in place. */
+    using ProcessFunction = std::function<void(float* const* channels, int numChannels, int numSamples)>;
+
+    BlockPipeline();
+    ~BlockPipeline();
+
+    /** Allocates the FIFOs (unless the last ones are big enough) and starts the worker. Not real-time safe. */
+    void start(int numChannels, int maxBlockSize, ProcessFunction process);
+
+    /** Stops the worker; call while the host isn't processing. */
+    void stop();
+
+    bool isRunning() const noexcept { return worker != nullptr; }
+    int getLatencySamples() const noexcept { return latency; }
+
+    /** Host thread: queues the block for the worker and replaces it with the samples
+        from one latency ago, or with silence if the worker is late. Wait-free, unless
+        catchUp is set: then a late block is processed on the calling thread instead.
+    */
+    void exchange(float* const* channels, int numChannels, int numSamples, bool catchUp = false) noexcept;
+
+    /** Blocks the host had to fill with silence because the worker was late. */
+    juce::int64 getNumUnderruns() const noexcept { return numUnderruns.load(std::memory_order_relaxed); }
+
+private:
+    class Worker;
+
+    /** Processes what is queued unless the other thread already is; false if it was. */
+    bool tryProcessPending() noexcept;
+    void processPending() noexcept;
+
+    static void write(juce::AbstractFifo& fifo, juce::AudioBuffer<float>& storage,
+                      const float* const* channels, int numChannels, int numSamples) noexcept;
+    static void read(juce::AbstractFifo& fifo, juce::AudioBuffer<float>& storage,
+                     float* const* channels, int numChannels, int numSamples) noexcept;
+
+    ProcessFunction process;
+    int latency{ 0 };
+
+    // Host -> worker and worker -> host, each with its own single producer and consumer.
+    std::unique_ptr<juce::AbstractFifo> inputFifo, outputFifo;
+    juce::AudioBuffer<float> inputStorage, outputStorage;
+    juce::AudioBuffer<float> workBuffer;
+
+    // Held by the worker or a catching-up host thread while it runs process().
+    std::atomic<bool> processing{ false };
+
+    // Host thread only: late samples still to be thrown away when they arrive.
+    int samplesToDiscard{ 0 };
+    std::atomic<juce::int64> numUnderruns{ 0 };
+
+    WakeSemaphore wake;
+    std::unique_ptr<Worker> worker;
+
+    JUCE_DECLARE_NON_COPYABLE(BlockPipeline)
+};
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    ChainSettings.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ChainSettings.h"
+#include "PluginProcessor.h"
+
+ChainSettings ChainSettings::fromParameters(const juce::AudioProcessorValueTreeState& apvts) {
+
+    using namespace Params;
+    const auto& params = GetParams();
+
+    auto getFloat = [&apvts, &params](Names name) {
+        return apvts.getRawParameterValue(params.at(name))->load();
+    };
+
+    auto getBool = [&](Names name) {
+        return getFloat(name) > 0.5f;
+    };
+
+    auto getRatio = [&apvts, &params](Names name) {
+        auto* choice = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(name)));
+        jassert(choice != nullptr);
+        return choice->getCurrentChoiceName().getFloatValue();
+    };
+
+    ChainSettings settings;
+
+    settings.inputGain = getFloat(Names::Gain_In);
+    settings.outputGain = getFloat(Names::Gain_Out);
+    settings.lowMidCrossover = getFloat(Names::Low_Mid_Crossover_Freq);
+    settings.midHighCrossover = getFloat(Names::Mid_High_Crossover_Freq);
+
+    const Names threshold[] = { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band };
+    const Names attack[] = { Attack_Low_Band, Attack_Mid_Band, Attack_High_Band };
+    const Names release[] = { Release_Low_Band, Release_Mid_Band, Release_High_Band };
+    const Names ratio[] = { Ratio_Low_Band, Ratio_Mid_Band, Ratio_High_Band };
+    const Names bypassed[] = { Bypassed_Low_Band, Bypassed_Mid_Band, Bypassed_High_Band };
+    const Names mute[] = { Mute_Low_Band, Mute_Mid_Band, Mute_High_Band };
+    const Names solo[] = { Solo_Low_Band, Solo_Mid_Band, Solo_High_Band };
+
+    for (size_t i = 0; i < settings.bands.size(); ++i) {
+        auto& band = settings.bands[i];
+        band.threshold = getFloat(threshold[i]);
+        band.attack = getFloat(attack[i]);
+        band.release = getFloat(release[i]);
+        band.ratio = getRatio(ratio[i]);
+        band.bypassed = getBool(bypassed[i]);
+        band.mute = getBool(mute[i]);
+        band.solo = getBool(solo[i]);
+    }
+
+    return settings;
+}
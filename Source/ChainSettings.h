@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    ChainSettings.h
+    Created: 19 Oct 2026
+
+    Plain snapshot of every parameter of the chain, for code that runs the
+    DSP without going through the APVTS (reference chain, offline tools).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+struct ChainSettings {
+
+    struct Band {
+        float threshold{ 0 };
+        float attack{ 50 };
+        float release{ 250 };
+        float ratio{ 3 };
+        bool bypassed{ false };
+        bool mute{ false };
+        bool solo{ false };
+    };
+
+    float inputGain{ 0 };
+    float outputGain{ 0 };
+    float lowMidCrossover{ 400 };
+    float midHighCrossover{ 2000 };
+
+    std::array<Band, 3> bands;
+
+    /** Reads the current parameter values (real units, ratio as the number in the choice name). */
+    static ChainSettings fromParameters(const juce::AudioProcessorValueTreeState& apvts);
+};
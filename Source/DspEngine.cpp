@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+    DspEngine.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DspEngine.h"
+
+DspEngine::Parameters DspEngine::getDefaultParameters() noexcept {
+    Parameters p{};
+    p.low_mid_crossover_hz = 400.0f;
+    p.mid_high_crossover_hz = 2000.0f;
+    p.input_gain_db = 0.0f;
+    p.output_gain_db = 0.0f;
+
+    for (auto& band : p.bands) {
+        band.threshold_db = 0.0f;
+        band.ratio = 3.0f;
+        band.attack_ms = 50.0f;
+        band.release_ms = 250.0f;
+    }
+
+    return p;
+}
+
+void DspEngine::prepare(double sampleRate, int numChannels, int newMaxBlockSize) {
+    jassert(newMaxBlockSize > 0);
+    numChannels = juce::jmin(numChannels, DspStateArena::maxChannels);
+
+    // Hosts re-prepare when only the block size changes, or with nothing changed at all.
+    const auto sameFormat = isPrepared() && numChannels == arena.getNumChannels()
+                         && sampleRate == arena.getControls().sampleRate;
+
+    arena.allocate(numChannels, newMaxBlockSize);
+
+    if ((size_t)(numChannels * newMaxBlockSize) > planarScratchSize) {
+        planarScratchSize = (size_t)(numChannels * newMaxBlockSize);
+        planarScratch.allocate(planarScratchSize, true);
+    }
+
+    maxBlockSize = newMaxBlockSize;
+
+    // The filters keep running where they were, coefficients and ramps included.
+    if (sameFormat)
+        return;
+
+    arena.clearState();
+
+    auto& controls = arena.getControls();
+    controls.sampleRate = sampleRate;
+    DspKernels::makeDetectorInterpolator(controls);
+
+    DspKernels::resetGainRamp(controls.inputGain, sampleRate, 0.05); //50ms
+    DspKernels::resetGainRamp(controls.outputGain, sampleRate, 0.05);
+
+    // The state was cleared, there is nothing left to fade from.
+    splitFadeLength = juce::jmax(1, juce::roundToInt(sampleRate * splitFadeSeconds));
+    splitFadeRemaining = 0;
+
+    // Force the coefficients to be recomputed for the new sample rate.
+    coefficientsAreValid = false;
+    setParameters(applied);
+}
+
+void DspEngine::reset() noexcept {
+    arena.clearState();
+    splitFadeRemaining = 0;
+}
+
+void DspEngine::setNumThreads(int numThreads) {
+    numThreads = juce::jmax(1, numThreads);
+    if (numThreads == getNumThreads())
+        return;
+
+    taskPool.reset();
+    if (numThreads > 1)
+        taskPool = std::make_unique<DspTaskPool>(numThreads);
+}
+
+void DspEngine::setParameters(const Parameters& p) noexcept {
+    if (!isPrepared()) {
+        // Kept for prepare(), which has the sample rate the coefficients need.
+        applied = p;
+        return;
+    }
+
+    auto& controls = arena.getControls();
+
+    for (int band = 0; band < DspStateArena::numBands; ++band) {
+        const auto& b = p.bands[band];
+        const auto& last = applied.bands[band];
+
+        if (coefficientsAreValid && b.threshold_db == last.threshold_db && b.ratio == last.ratio
+            && b.attack_ms == last.attack_ms && b.release_ms == last.release_ms)
+            continue;
+
+        DspKernels::setCompressorCoeffs(controls, band, b.threshold_db, b.ratio, b.attack_ms, b.release_ms);
+    }
+
+    if (!coefficientsAreValid || p.low_mid_crossover_hz != applied.low_mid_crossover_hz)
+        controls.lowMid = DspKernels::makeCrossoverCoeffs(p.low_mid_crossover_hz, controls.sampleRate);
+
+    if (!coefficientsAreValid || p.mid_high_crossover_hz != applied.mid_high_crossover_hz)
+        controls.midHigh = DspKernels::makeCrossoverCoeffs(p.mid_high_crossover_hz, controls.sampleRate);
+
+    DspKernels::setGainRampTarget(controls.inputGain, p.input_gain_db);
+    DspKernels::setGainRampTarget(controls.outputGain, p.output_gain_db);
+
+    applied = p;
+    coefficientsAreValid = true;
+}
+
+void DspEngine::setQuality(const Quality& newQuality) noexcept {
+    jassert(newQuality.detectorInterval >= 1);
+
+    if (newQuality == quality)
+        return;
+
+    if (isPrepared() && newQuality.complementarySplit != quality.complementarySplit) {
+        // The outgoing split carries on from a copy of its state while the new one fades in.
+        const auto numChannels = arena.getNumChannels();
+        for (int i = 0; i < DspStateArena::numCrossoverStates; ++i)
+            std::copy(arena.getCrossoverState(i), arena.getCrossoverState(i) + numChannels, arena.getFadeCrossoverState(i));
+
+        // The complementary split leaves the high-pass and all-pass stages alone; whatever
+        // they held is long stale, so the LR4 split starts them from silence instead.
+        if (!newQuality.complementarySplit) {
+            using S = DspStateArena::CrossoverState;
+            for (auto i : { S::lowMidHighS3, S::lowMidHighS4, S::allPassS1, S::allPassS2, S::midHighHighS3, S::midHighHighS4 })
+                std::fill(arena.getCrossoverState(i), arena.getCrossoverState(i) + numChannels, 0.0f);
+        }
+
+        splitFadeRemaining = splitFadeLength;
+    }
+
+    // The interpolator's history isn't kept up while it is off; a few samples of silence
+    // are closer to the truth than whatever it last saw.
+    if (isPrepared() && newQuality.oversampledDetector && !quality.oversampledDetector)
+        for (int band = 0; band < DspStateArena::numBands; ++band)
+            std::fill(arena.getDetectorHistory(band),
+                      arena.getDetectorHistory(band) + DspStateArena::detectorTaps * arena.getNumChannels(), 0.0f);
+
+    // The per-sample compressor doesn't keep its gain, the control-rate one ramps from there.
+    const auto usesDetectorGain = [](const Quality& q) { return q.detectorInterval > 1 && !q.oversampledDetector; };
+
+    if (isPrepared() && !usesDetectorGain(quality) && usesDetectorGain(newQuality)) {
+        const auto& controls = arena.getControls();
+
+        for (int band = 0; band < DspStateArena::numBands; ++band) {
+            const auto* envelope = arena.getEnvelopeState(band);
+            auto* gain = arena.getDetectorGain(band);
+
+            for (int ch = 0; ch < arena.getNumChannels(); ++ch)
+                gain[ch] = envelope[ch] < controls.threshold[band]
+                    ? 1.0f : std::pow(envelope[ch] * controls.thresholdInverse[band], controls.ratioExponent[band]);
+        }
+    }
+
+    quality = newQuality;
+}
+
+//==============================================================================
+void DspEngine::process(float* const* channels, int numChannels, int numSamples) noexcept {
+    jassert(isPrepared() && numChannels <= arena.getNumChannels());
+
+    // Calls longer than maxBlockSize go through the fixed-size arena in several passes.
+    float* chunk[DspStateArena::maxChannels];
+
+    for (int start = 0; start < numSamples; start += maxBlockSize) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk[ch] = channels[ch] + start;
+
+        processChunk(chunk, numChannels, juce::jmin(maxBlockSize, numSamples - start));
+    }
+}
+
+void DspEngine::processInterleaved(float* frames, int numChannels, int numFrames) noexcept {
+    jassert(isPrepared() && numChannels <= arena.getNumChannels());
+
+    float* planar[DspStateArena::maxChannels];
+    for (int ch = 0; ch < numChannels; ++ch)
+        planar[ch] = planarScratch.get() + ch * maxBlockSize;
+
+    for (int start = 0; start < numFrames; start += maxBlockSize) {
+        const auto numSamples = juce::jmin(maxBlockSize, numFrames - start);
+        auto* block = frames + (size_t)start * (size_t)numChannels;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int n = 0; n < numSamples; ++n)
+                planar[ch][n] = block[n * numChannels + ch];
+
+        processChunk(planar, numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int n = 0; n < numSamples; ++n)
+                block[n * numChannels + ch] = planar[ch][n];
+    }
+}
+
+void DspEngine::processChunk(float* const* channels, int numChannels, int numSamples) noexcept {
+    if (taskPool != nullptr) {
+        processChunkInParallel(channels, numChannels, numSamples);
+        return;
+    }
+
+    applyInputGain(channels, numChannels, numSamples);
+    splitBands(channels, numChannels, numSamples);
+
+    for (int band = 0; band < DspStateArena::numBands; ++band)
+        compressBand(band, numChannels, numSamples);
+
+    sumBands(channels, numChannels, numSamples);
+    applyOutputGain(channels, numChannels, numSamples);
+}
+
+void DspEngine::processChunkInParallel(float* const* channels, int numChannels, int numSamples) noexcept {
+    applyInputGain(channels, numChannels, numSamples);
+
+    auto& chunk = parallelChunk;
+    chunk.channels = channels;
+    chunk.numChannels = numChannels;
+    chunk.numSamples = numSamples;
+    chunk.channelsPerGroup = (numChannels + taskPool->getNumThreads() - 1) / taskPool->getNumThreads();
+    getBandEnabled(chunk.bandEnabled);
+
+    const auto numGroups = (numChannels + chunk.channelsPerGroup - 1) / chunk.channelsPerGroup;
+    const int numTasks[numParallelPhases] = { numGroups, numGroups * DspStateArena::numBands, numGroups };
+
+    taskPool->run(&DspEngine::runTask, this, numTasks, numParallelPhases);
+    advanceSplitFade(numSamples);
+
+    applyOutputGain(channels, numChannels, numSamples);
+}
+
+void DspEngine::runTask(void* context, int phase, int task) {
+    auto& engine = *static_cast<DspEngine*>(context);
+    const auto& chunk = engine.parallelChunk;
+    const auto& kernels = DspKernels::getKernels();
+
+    const auto group = phase == compressPhase ? task / DspStateArena::numBands : task;
+    const auto first = group * chunk.channelsPerGroup;
+    const auto count = juce::jmin(chunk.channelsPerGroup, chunk.numChannels - first);
+
+    float* bandChannels[DspStateArena::numBands * DspStateArena::maxChannels];
+    const auto view = engine.arena.getView(first, count, bandChannels);
+
+    switch (phase) {
+        case splitPhase: {
+            float* fadeBandChannels[DspStateArena::numBands * DspStateArena::maxChannels];
+            const auto fadeView = engine.arena.getFadeView(first, count, fadeBandChannels);
+            engine.splitGroup(view, fadeView, chunk.channels + first, count, chunk.numSamples);
+            break;
+        }
+
+        case compressPhase: {
+            const auto band = task % DspStateArena::numBands;
+            if (!engine.applied.bands[band].bypassed)
+                engine.compressGroup(view, band, count, chunk.numSamples);
+            break;
+        }
+
+        case sumPhase:
+            kernels.sumBands(view, chunk.bandEnabled, chunk.channels + first, count, chunk.numSamples);
+            break;
+
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+void DspEngine::applyInputGain(float* const* channels, int numChannels, int numSamples) noexcept {
+    DspKernels::applyGainRamp(arena.getControls().inputGain, arena.getGainScratch(), channels, numChannels, numSamples);
+}
+
+void DspEngine::splitBands(const float* const* input, int numChannels, int numSamples) noexcept {
+    float* fadeBandChannels[DspStateArena::numBands * DspStateArena::maxChannels];
+    splitGroup(arena.getView(), arena.getFadeView(0, arena.getNumChannels(), fadeBandChannels), input, numChannels, numSamples);
+    advanceSplitFade(numSamples);
+}
+
+void DspEngine::compressBand(int band, int numChannels, int numSamples) noexcept {
+    if (applied.bands[band].bypassed) {
+        std::fill(arena.getMinGain(band), arena.getMinGain(band) + numChannels, 1.0f);
+        return;
+    }
+
+    compressGroup(arena.getView(), band, numChannels, numSamples);
+}
+
+float DspEngine::getMinGain(int band, int numChannels) const noexcept {
+    const auto* minGain = arena.getMinGain(band);
+    return *std::min_element(minGain, minGain + juce::jmax(1, numChannels));
+}
+
+void DspEngine::splitGroup(const DspStateArena::View& view, const DspStateArena::View& fadeView,
+                           const float* const* input, int numChannels, int numSamples) const noexcept {
+    const auto& kernels = DspKernels::getKernels();
+    const auto split = quality.complementarySplit ? kernels.splitBandsComplementary : kernels.splitBands;
+    split(view, input, numChannels, numSamples);
+
+    if (splitFadeRemaining <= 0)
+        return;
+
+    const auto outgoing = quality.complementarySplit ? kernels.splitBands : kernels.splitBandsComplementary;
+    outgoing(fadeView, input, numChannels, numSamples);
+
+    const auto fadeStart = splitFadeLength - splitFadeRemaining;
+
+    for (int band = 0; band < DspStateArena::numBands; ++band) {
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* in = view.bandChannels[band * view.numChannels + ch];
+            const auto* out = fadeView.bandChannels[band * fadeView.numChannels + ch];
+
+            for (int n = 0; n < numSamples; ++n) {
+                const auto t = juce::jmin(1.0f, (float)(fadeStart + n + 1) / (float)splitFadeLength);
+                in[n] = out[n] + t * (in[n] - out[n]);
+            }
+        }
+    }
+}
+
+void DspEngine::compressGroup(const DspStateArena::View& view, int band, int numChannels, int numSamples) const noexcept {
+    const auto& kernels = DspKernels::getKernels();
+
+    if (quality.oversampledDetector)
+        kernels.compressBandOversampled(view, band, numChannels, numSamples);
+    else if (quality.detectorInterval > 1)
+        kernels.compressBandControlRate(view, band, quality.detectorInterval, numChannels, numSamples);
+    else
+        kernels.compressBand(view, band, numChannels, numSamples);
+}
+
+void DspEngine::sumBands(float* const* output, int numChannels, int numSamples) noexcept {
+    bool bandEnabled[DspStateArena::numBands];
+    getBandEnabled(bandEnabled);
+
+    DspKernels::sumBands(arena, bandEnabled, output, numChannels, numSamples);
+}
+
+void DspEngine::getBandEnabled(bool* bandEnabled) const noexcept {
+    auto bandsAreSoloed = false;
+    for (auto& b : applied.bands)
+        bandsAreSoloed = bandsAreSoloed || b.solo != 0;
+
+    for (int band = 0; band < DspStateArena::numBands; ++band)
+        bandEnabled[band] = bandsAreSoloed ? applied.bands[band].solo != 0 : applied.bands[band].mute == 0;
+}
+
+void DspEngine::applyOutputGain(float* const* channels, int numChannels, int numSamples) noexcept {
+    DspKernels::applyGainRamp(arena.getControls().outputGain, arena.getGainScratch(), channels, numChannels, numSamples);
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    DspEngine.h
+    Created: 19 Oct 2026
+
+    The whole processing chain on plain parameter values, with no plugin
+    around it: Multiband_compAudioProcessor feeds it from its parameters,
+    the C API (mbc_core.h) from whatever embeds it.
+
+    With setNumThreads > 1, process() spreads each chunk over a DspTaskPool:
+    the crossover per channel group, then each band of each group, then the
+    band sum per group. Channels and bands don't share state, so the output
+    is bit-identical to the serial path; only the gain ramps stay serial.
+
+    setQuality() trades precision for CPU (see QualityGovernor): the
+    compressor gain can be computed at a control rate instead of per sample,
+    and the LR4 split can give way to a cheaper complementary one. Offline
+    renders go the other way and oversample the detector. Changes are
+    glitch-free and none of them adds latency: the detector gain is
+    interpolated, and a change of split crossfades from the outgoing
+    topology over splitFadeSeconds.
+
+    prepare() is the only call that allocates. The stages are public so the
+    processor can time them one by one and the sweep renderer can stop
+    after the crossover; process() runs them all.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspKernels.h"
+#include "DspTaskPool.h"
+#include "mbc_core.h"
+
+class DspEngine {
+public:
+    using Parameters = mbc_params;
+    using BandParameters = mbc_band_params;
+
+    static_assert(MBC_NUM_BANDS == DspStateArena::numBands && MBC_MAX_CHANNELS == DspStateArena::maxChannels,
+                  "mbc_core.h and DspStateArena disagree");
+
+    /** The plugin's defaults. */
+    static Parameters getDefaultParameters() noexcept;
+
+    /** Allocates and clears the state; throws std::bad_alloc if that fails. Parameters
+        already set stay and are applied at the new sample rate. Like the plugin, the
+        gains fade in from silence after the first prepare only.
+
+        Again at the same rate with as many channels, only the block size can change:
+        the buffers are reused if they are long enough and the state is kept.
+    */
+    void prepare(double sampleRate, int numChannels, int maxBlockSize);
+
+    /** Clears the filter and envelope state; not while processing. */
+    void reset() noexcept;
+
+    bool isPrepared() const noexcept { return maxBlockSize > 0; }
+    int getNumChannels() const noexcept { return arena.getNumChannels(); }
+    int getMaxBlockSize() const noexcept { return maxBlockSize; }
+    double getSampleRate() const noexcept { return arena.getControls().sampleRate; }
+
+    /** Starts or stops worker threads, 1 processes on the calling thread only. Not real-time
+        safe and not while processing; meant for offline renders, where waking the workers
+        every chunk is cheap next to the chunk itself.
+    */
+    void setNumThreads(int numThreads);
+    int getNumThreads() const noexcept { return taskPool != nullptr ? taskPool->getNumThreads() : 1; }
+
+    /** Recomputes coefficients only for the values that changed. Expects what
+        mbc_set_params accepts; crossovers at or above Nyquist are held just below it.
+    */
+    void setParameters(const Parameters& parameters) noexcept;
+
+    struct Quality {
+        int detectorInterval{ 1 };          // samples per compressor gain computation
+        bool complementarySplit{ false };   // instead of the LR4 three-way split
+        bool oversampledDetector{ false };  // per-sample gain from inter-sample peaks, overrides detectorInterval
+
+        bool operator==(const Quality& other) const noexcept {
+            return detectorInterval == other.detectorInterval && complementarySplit == other.complementarySplit
+                && oversampledDetector == other.oversampledDetector;
+        }
+        bool operator!=(const Quality& other) const noexcept { return !operator==(other); }
+    };
+
+    static constexpr double splitFadeSeconds = 0.01;
+
+    /** Real-time safe, call between chunks like setParameters. The default is full quality. */
+    void setQuality(const Quality& newQuality) noexcept;
+    const Quality& getQuality() const noexcept { return quality; }
+
+    /** In place, any number of samples. */
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+    void processInterleaved(float* frames, int numChannels, int numFrames) noexcept;
+
+    //==============================================================================
+    // The stages of process(), in order. At most getMaxBlockSize() samples each.
+
+    void applyInputGain(float* const* channels, int numChannels, int numSamples) noexcept;
+    void splitBands(const float* const* input, int numChannels, int numSamples) noexcept;
+    void compressBand(int band, int numChannels, int numSamples) noexcept;
+    void sumBands(float* const* output, int numChannels, int numSamples) noexcept;
+    void applyOutputGain(float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** The lowest gain band's compressor applied over the first numChannels in the last
+        compressBand call, 1 for a bypassed band. What the gain reduction meters show.
+    */
+    float getMinGain(int band, int numChannels) const noexcept;
+
+    DspStateArena& getArena() noexcept { return arena; }
+    const DspStateArena& getArena() const noexcept { return arena; }
+
+private:
+    void processChunk(float* const* channels, int numChannels, int numSamples) noexcept;
+    // Each phase reads what the one before wrote, the pool puts a barrier between them.
+    enum ParallelPhase { splitPhase, compressPhase, sumPhase, numParallelPhases };
+
+    void processChunkInParallel(float* const* channels, int numChannels, int numSamples) noexcept;
+    static void runTask(void* engine, int phase, int task);
+
+    void getBandEnabled(bool* bandEnabled) const noexcept;
+
+    // Both paths go through these, so the parallel one picks the same kernels.
+    void splitGroup(const DspStateArena::View& view, const DspStateArena::View& fadeView,
+                    const float* const* input, int numChannels, int numSamples) const noexcept;
+    void compressGroup(const DspStateArena::View& view, int band, int numChannels, int numSamples) const noexcept;
+    void advanceSplitFade(int numSamples) noexcept { splitFadeRemaining = juce::jmax(0, splitFadeRemaining - numSamples); }
+
+    DspStateArena arena;
+    int maxBlockSize{ 0 };
+
+    // De-interleaved copy for processInterleaved, allocated with the arena.
+    juce::HeapBlock<float, true> planarScratch;
+    size_t planarScratchSize{ 0 };
+
+    Parameters applied{ getDefaultParameters() };
+    bool coefficientsAreValid{ false };
+
+    Quality quality;
+    int splitFadeLength{ 1 };
+    int splitFadeRemaining{ 0 };        // samples until the outgoing split is dropped
+
+    // The chunk the task pool is working on, see processChunkInParallel.
+    struct ParallelChunk {
+        float* const* channels;
+        int numChannels, numSamples;
+        int channelsPerGroup;
+        bool bandEnabled[DspStateArena::numBands];
+    };
+
+    std::unique_ptr<DspTaskPool> taskPool;
+    ParallelChunk parallelChunk{};
+};
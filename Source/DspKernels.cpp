@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    DspKernels.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+namespace DspKernels {
+
+    //==============================================================================
+    DspStateArena::CrossoverCoeffs makeCrossoverCoeffs(float cutoffFrequency, double sampleRate) noexcept {
+        DspStateArena::CrossoverCoeffs c;
+        // tan() runs off to infinity at Nyquist; a re-prepare at a lower rate can get there.
+        const auto cutoff = juce::jmin((double)cutoffFrequency, sampleRate * 0.49);
+        c.g = (float)std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+        c.R2 = (float)std::sqrt(2.0);
+        c.h = (float)(1.0 / (1.0 + c.R2 * c.g + c.g * c.g));
+        c.R2PlusG = c.R2 + c.g;
+        return c;
+    }
+
+    void setCompressorCoeffs(DspStateArena::Controls& controls, int band,
+                             float thresholdDb, float ratio, float attackMs, float releaseMs) noexcept {
+        jassert(ratio >= 1.0f);
+
+        controls.threshold[band] = juce::Decibels::decibelsToGain(thresholdDb, -200.0f);
+        controls.thresholdInverse[band] = 1.0f / controls.threshold[band];
+        controls.ratioExponent[band] = 1.0f / ratio - 1.0f;
+
+        // BallisticsFilter keeps this factor as a float, so do we.
+        const auto expFactor = (float)(-2.0 * juce::MathConstants<double>::pi * 1000.0 / controls.sampleRate);
+        auto limitedCte = [expFactor](float timeMs) {
+            return timeMs < 1.0e-3f ? 0.0f : std::exp(expFactor / timeMs);
+        };
+
+        controls.attackCoeff[band] = limitedCte(attackMs);
+        controls.releaseCoeff[band] = limitedCte(releaseMs);
+
+        const auto oversampling = (float)DspStateArena::detectorOversampling;
+        controls.oversampledAttackCoeff[band] = limitedCte(attackMs * oversampling);
+        controls.oversampledReleaseCoeff[band] = limitedCte(releaseMs * oversampling);
+    }
+
+    void makeDetectorInterpolator(DspStateArena::Controls& controls) noexcept {
+        constexpr auto factor = DspStateArena::detectorOversampling;
+        constexpr auto length = factor * DspStateArena::detectorTaps;
+        const auto pi = juce::MathConstants<double>::pi;
+
+        // Kaiser-windowed sinc, cut off at the original Nyquist. Phase p of the polyphase
+        // form takes every factor-th tap; each phase is normalised to unity gain at DC.
+        auto bessel = [](double x) {
+            double sum = 1.0, term = 1.0;
+            for (int k = 1; k < 32; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        };
+
+        const auto beta = 6.0;
+        double taps[length];
+
+        for (int i = 0; i < length; ++i) {
+            const auto t = (i - (length - 1) * 0.5) / factor;
+            const auto sinc = t == 0.0 ? 1.0 : std::sin(pi * t) / (pi * t);
+            const auto w = 2.0 * i / (length - 1) - 1.0;
+            taps[i] = sinc * bessel(beta * std::sqrt(1.0 - w * w)) / bessel(beta);
+        }
+
+        for (int phase = 0; phase < factor; ++phase) {
+            double sum = 0.0;
+            for (int k = 0; k < DspStateArena::detectorTaps; ++k)
+                sum += taps[phase + k * factor];
+
+            for (int k = 0; k < DspStateArena::detectorTaps; ++k)
+                controls.detectorInterpolator[phase][k] = (float)(taps[phase + k * factor] / sum);
+        }
+    }
+
+    void resetGainRamp(DspStateArena::GainRamp& ramp, double sampleRate, double rampSeconds) noexcept {
+        ramp.stepsToTarget = (int)std::floor(rampSeconds * sampleRate);
+        ramp.current = ramp.target;
+        ramp.countdown = 0;
+    }
+
+    void setGainRampTarget(DspStateArena::GainRamp& ramp, float gainDecibels) noexcept {
+        const auto newTarget = juce::Decibels::decibelsToGain(gainDecibels);
+
+        if (newTarget == ramp.target)
+            return;
+
+        if (ramp.stepsToTarget <= 0) {
+            ramp.current = ramp.target = newTarget;
+            ramp.countdown = 0;
+            return;
+        }
+
+        ramp.target = newTarget;
+        ramp.countdown = ramp.stepsToTarget;
+        ramp.step = (ramp.target - ramp.current) / (float)ramp.countdown;
+    }
+
+    //==============================================================================
+    namespace {
+        bool cpuSupports(Isa isa) noexcept {
+            switch (isa) {
+                case Isa::generic: return true;
+                case Isa::sse2:    return juce::SystemStats::hasSSE2();
+                case Isa::avx2:    return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+                // The scheme builds with VL (and, with /arch:AVX512, BW and DQ), which F alone doesn't imply.
+                case Isa::avx512:  return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL()
+                                       && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512DQ();
+                case Isa::numIsas: break;
+            }
+            return false;
+        }
+
+        const KernelTable* getTable(Isa isa) noexcept {
+            switch (isa) {
+                case Isa::generic: return getGenericKernels();
+                case Isa::sse2:    return getSse2Kernels();
+                case Isa::avx2:    return getAvx2Kernels();
+                case Isa::avx512:  return getAvx512Kernels();
+                case Isa::numIsas: break;
+            }
+            return nullptr;
+        }
+
+        Isa selectIsa() noexcept {
+            // std::getenv rather than SystemStats: this runs during static initialisation.
+            if (const auto* forced = std::getenv("MBC_FORCE_ISA")) {
+                for (int i = 0; i < (int)Isa::numIsas; ++i) {
+                    const auto isa = (Isa)i;
+                    if (std::strcmp(forced, getIsaName(isa)) == 0) {
+                        if (isIsaAvailable(isa))
+                            return isa;
+
+                        jassertfalse; // forced ISA not built in or not supported by this CPU
+                        break;
+                    }
+                }
+            }
+
+            for (int i = (int)Isa::numIsas - 1; i > 0; --i) {
+                if (isIsaAvailable((Isa)i))
+                    return (Isa)i;
+            }
+            return Isa::generic;
+        }
+
+        std::atomic<Isa> activeIsa{ selectIsa() };
+        std::atomic<const KernelTable*> activeKernels{ getTable(activeIsa.load()) };
+    }
+
+    const KernelTable& getKernels() noexcept {
+        return *activeKernels.load(std::memory_order_relaxed);
+    }
+
+    Isa getActiveIsa() noexcept {
+        return activeIsa.load(std::memory_order_relaxed);
+    }
+
+    bool isIsaAvailable(Isa isa) noexcept {
+        return getTable(isa) != nullptr && cpuSupports(isa);
+    }
+
+    bool forceIsa(Isa isa) noexcept {
+        if (!isIsaAvailable(isa))
+            return false;
+
+        activeIsa.store(isa);
+        activeKernels.store(getTable(isa));
+        return true;
+    }
+
+    const char* getIsaName(Isa isa) noexcept {
+        switch (isa) {
+            case Isa::generic: return "generic";
+            case Isa::sse2:    return "sse2";
+            case Isa::avx2:    return "avx2";
+            case Isa::avx512:  return "avx512";
+            case Isa::numIsas: break;
+        }
+        return "";
+    }
+}
+
+// Portable build of the kernels, compiled with the project's default flags.
+#define MBC_KERNEL_ISA generic
+#include "DspKernelsImpl.h"
+#undef MBC_KERNEL_ISA
+
+const DspKernels::KernelTable* DspKernels::getGenericKernels() noexcept {
+    return &generic::kernels;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    DspKernels.h
+    Created: 19 Oct 2026
+
+    The per-sample loops of the processing chain, working directly on the
+    DspStateArena. The maths is the same as the juce::dsp classes it replaced
+    (LinkwitzRileyFilter, Compressor/BallisticsFilter, Gain).
+
+    The loops themselves live in DspKernelsImpl.h and are compiled once per
+    instruction set (DspKernels_SSE2/AVX2/AVX512.cpp, see the compiler flag
+    schemes in the .jucer); this file picks one at load time.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspStateArena.h"
+
+namespace DspKernels {
+
+    //==============================================================================
+    // Coefficients, called from updateState - not per sample.
+
+    DspStateArena::CrossoverCoeffs makeCrossoverCoeffs(float cutoffFrequency, double sampleRate) noexcept;
+
+    void setCompressorCoeffs(DspStateArena::Controls& controls, int band,
+                             float thresholdDb, float ratio, float attackMs, float releaseMs) noexcept;
+
+    /** Fills the oversampled detector's interpolation filter; depends on nothing, call once. */
+    void makeDetectorInterpolator(DspStateArena::Controls& controls) noexcept;
+
+    /** Resets the ramp length and jumps to the target, like SmoothedValue::reset(sampleRate, seconds). */
+    void resetGainRamp(DspStateArena::GainRamp& ramp, double sampleRate, double rampSeconds) noexcept;
+    void setGainRampTarget(DspStateArena::GainRamp& ramp, float gainDecibels) noexcept;
+
+    //==============================================================================
+    // Hot loop. Each instruction set gets its own build of these (DspKernelsImpl.h),
+    // the best one the CPU supports is picked once when the plugin is loaded.
+
+    struct KernelTable {
+        const char* name;
+
+        void (*applyGainRamp)(DspStateArena::GainRamp& ramp, float* gainScratch,
+                              float* const* channels, int numChannels, int numSamples) noexcept;
+
+        /** LR4 three-way split of the input into the arena's band buffers. */
+        void (*splitBands)(const DspStateArena::View& arena, const float* const* input, int numChannels, int numSamples) noexcept;
+
+        /** LR4 low-pass per crossover, the upper bands by subtraction: about half the work of splitBands. */
+        void (*splitBandsComplementary)(const DspStateArena::View& arena, const float* const* input,
+                                        int numChannels, int numSamples) noexcept;
+
+        /** Peak-detecting compressor, in place on one band buffer. All three variants leave
+            the lowest gain they applied to each channel in the band's minGain row.
+        */
+        void (*compressBand)(const DspStateArena::View& arena, int band, int numChannels, int numSamples) noexcept;
+
+        /** compressBand with the gain computed every interval samples and interpolated in between. */
+        void (*compressBandControlRate)(const DspStateArena::View& arena, int band, int interval,
+                                        int numChannels, int numSamples) noexcept;
+
+        /** compressBand with the envelope following the band interpolated to detectorOversampling
+            times the rate, so peaks between samples count too. The audio itself isn't resampled.
+        */
+        void (*compressBandOversampled)(const DspStateArena::View& arena, int band, int numChannels, int numSamples) noexcept;
+
+        /** output = sum of the bands whose bandEnabled flag is set. */
+        void (*sumBands)(const DspStateArena::View& arena, const bool* bandEnabled,
+                         float* const* output, int numChannels, int numSamples) noexcept;
+    };
+
+    enum class Isa {
+        generic,
+        sse2,
+        avx2,
+        avx512,
+
+        numIsas
+    };
+
+    /** The table in use. Chosen at static-init time from the CPU features, or from the
+        MBC_FORCE_ISA environment variable (generic, sse2, avx2, avx512) when it is set.
+    */
+    const KernelTable& getKernels() noexcept;
+    Isa getActiveIsa() noexcept;
+
+    /** True if this build contains kernels for the ISA and the CPU can run them. */
+    bool isIsaAvailable(Isa) noexcept;
+
+    /** Switches every instance to another kernel build, for tests and benchmarks.
+        Returns false (and changes nothing) if the ISA isn't available.
+    */
+    bool forceIsa(Isa) noexcept;
+
+    const char* getIsaName(Isa) noexcept;
+
+    // Per-ISA tables, nullptr when that translation unit was built without the matching compiler flags.
+    const KernelTable* getGenericKernels() noexcept;
+    const KernelTable* getSse2Kernels() noexcept;
+    const KernelTable* getAvx2Kernels() noexcept;
+    const KernelTable* getAvx512Kernels() noexcept;
+
+    inline void applyGainRamp(DspStateArena::GainRamp& ramp, float* gainScratch,
+                              float* const* channels, int numChannels, int numSamples) noexcept {
+        getKernels().applyGainRamp(ramp, gainScratch, channels, numChannels, numSamples);
+    }
+
+    inline void splitBands(DspStateArena& arena, const float* const* input, int numChannels, int numSamples) noexcept {
+        getKernels().splitBands(arena.getView(), input, numChannels, numSamples);
+    }
+
+    inline void compressBand(DspStateArena& arena, int band, int numChannels, int numSamples) noexcept {
+        getKernels().compressBand(arena.getView(), band, numChannels, numSamples);
+    }
+
+    inline void sumBands(DspStateArena& arena, const bool* bandEnabled,
+                         float* const* output, int numChannels, int numSamples) noexcept {
+        getKernels().sumBands(arena.getView(), bandEnabled, output, numChannels, numSamples);
+    }
+}
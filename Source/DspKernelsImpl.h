@@ -0,0 +1,363 @@
+/*
+  ==============================================================================
+
+    DspKernelsImpl.h
+    Created: 19 Oct 2026
+
+    Body of the hot-loop kernels. No include guard: every DspKernels_*.cpp
+    includes this once with MBC_KERNEL_ISA set to its namespace name, and the
+    compiler flags of that file decide which instructions come out.
+
+    Keep the loops plain - no juce::FloatVectorOperations, those are compiled
+    once for the baseline ISA inside juce_audio_basics and would not benefit.
+    Don't call inline functions from other headers either (std::abs, jmin,
+    DspStateArena accessors...): an unoptimised build may keep an AVX copy of
+    them that the linker then hands to the generic path. Only file-local
+    helpers, plain data and extern "C" maths.
+
+  ==============================================================================
+*/
+
+#ifndef MBC_KERNEL_ISA
+ #error "Define MBC_KERNEL_ISA before including DspKernelsImpl.h"
+#endif
+
+namespace DspKernels {
+namespace MBC_KERNEL_ISA {
+
+    static inline float absolute(float x) noexcept { return x < 0.0f ? -x : x; }
+
+    static inline void snapToZero(float& x) noexcept {
+        if (!(x < -1.0e-8f || x > 1.0e-8f))
+            x = 0.0f;
+    }
+
+    static void applyGainRamp(DspStateArena::GainRamp& ramp, float* gainScratch,
+                              float* const* channels, int numChannels, int numSamples) noexcept {
+
+        if (ramp.countdown <= 0) {
+            const auto gain = ramp.target;
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto* x = channels[ch];
+                for (int n = 0; n < numSamples; ++n)
+                    x[n] *= gain;
+            }
+            return;
+        }
+
+        for (int n = 0; n < numSamples; ++n) {
+            if (ramp.countdown > 0) {
+                --ramp.countdown;
+                ramp.current = ramp.countdown > 0 ? ramp.current + ramp.step : ramp.target;
+            }
+            gainScratch[n] = ramp.current;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* x = channels[ch];
+            for (int n = 0; n < numSamples; ++n)
+                x[n] *= gainScratch[n];
+        }
+    }
+
+    //==============================================================================
+    struct TptStage {
+        float yH, yB, yL;
+
+        inline void process(float x, float& s1, float& s2, const DspStateArena::CrossoverCoeffs& c) noexcept {
+            yH = (x - c.R2PlusG * s1 - s2) * c.h;
+            yB = c.g * yH + s1;
+            s1 = c.g * yH + yB;
+            yL = c.g * yB + s2;
+            s2 = c.g * yB + yL;
+        }
+    };
+
+    static void splitBands(const DspStateArena::View& arena, const float* const* input, int numChannels, int numSamples) noexcept {
+        using S = DspStateArena::CrossoverState;
+
+        const auto c0 = arena.controls->lowMid;
+        const auto c1 = arena.controls->midHigh;
+
+        float* state[S::numCrossoverStates];
+        for (int i = 0; i < S::numCrossoverStates; ++i)
+            state[i] = arena.crossoverState + i * arena.channelStride;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            float s[S::numCrossoverStates];
+            for (int i = 0; i < S::numCrossoverStates; ++i)
+                s[i] = state[i][ch];
+
+            const auto* in = input[ch];
+            auto* low = arena.bandChannels[0 * arena.numChannels + ch];
+            auto* mid = arena.bandChannels[1 * arena.numChannels + ch];
+            auto* high = arena.bandChannels[2 * arena.numChannels + ch];
+
+            TptStage a, b;
+
+            for (int n = 0; n < numSamples; ++n) {
+                // LP1 / HP1 at fc0
+                a.process(in[n], s[S::lowMidS1], s[S::lowMidS2], c0);
+                b.process(a.yL, s[S::lowMidLowS3], s[S::lowMidLowS4], c0);
+                const auto lowPassed = b.yL;
+                b.process(a.yH, s[S::lowMidHighS3], s[S::lowMidHighS4], c0);
+                const auto highPassed = b.yH;
+
+                // AP2 at fc1 keeps the low band in phase with the other two
+                a.process(lowPassed, s[S::allPassS1], s[S::allPassS2], c1);
+                low[n] = a.yL - c1.R2 * a.yB + a.yH;
+
+                // LP2 / HP2 at fc1
+                a.process(highPassed, s[S::midHighS1], s[S::midHighS2], c1);
+                b.process(a.yL, s[S::midHighLowS3], s[S::midHighLowS4], c1);
+                mid[n] = b.yL;
+                b.process(a.yH, s[S::midHighHighS3], s[S::midHighHighS4], c1);
+                high[n] = b.yH;
+            }
+
+            for (int i = 0; i < S::numCrossoverStates; ++i) {
+                snapToZero(s[i]);
+                state[i][ch] = s[i];
+            }
+        }
+    }
+
+    /** Cheaper split: one LR4 low-pass per crossover, the upper bands are what is left.
+        Sums back to the input exactly, but the bands overlap more than the LR4 ones.
+    */
+    static void splitBandsComplementary(const DspStateArena::View& arena, const float* const* input,
+                                        int numChannels, int numSamples) noexcept {
+        using S = DspStateArena::CrossoverState;
+
+        const auto c0 = arena.controls->lowMid;
+        const auto c1 = arena.controls->midHigh;
+
+        float* state[S::numCrossoverStates];
+        for (int i = 0; i < S::numCrossoverStates; ++i)
+            state[i] = arena.crossoverState + i * arena.channelStride;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            // Only the low-pass stages of each crossover, the others keep whatever they held.
+            float s0 = state[S::lowMidS1][ch], s1 = state[S::lowMidS2][ch];
+            float s2 = state[S::lowMidLowS3][ch], s3 = state[S::lowMidLowS4][ch];
+            float s4 = state[S::midHighS1][ch], s5 = state[S::midHighS2][ch];
+            float s6 = state[S::midHighLowS3][ch], s7 = state[S::midHighLowS4][ch];
+
+            const auto* in = input[ch];
+            auto* low = arena.bandChannels[0 * arena.numChannels + ch];
+            auto* mid = arena.bandChannels[1 * arena.numChannels + ch];
+            auto* high = arena.bandChannels[2 * arena.numChannels + ch];
+
+            TptStage a, b;
+
+            for (int n = 0; n < numSamples; ++n) {
+                a.process(in[n], s0, s1, c0);
+                b.process(a.yL, s2, s3, c0);
+                const auto lowPassed = b.yL;
+                const auto rest = in[n] - lowPassed;
+
+                a.process(rest, s4, s5, c1);
+                b.process(a.yL, s6, s7, c1);
+
+                low[n] = lowPassed;
+                mid[n] = b.yL;
+                high[n] = rest - b.yL;
+            }
+
+            snapToZero(s0); snapToZero(s1); snapToZero(s2); snapToZero(s3);
+            snapToZero(s4); snapToZero(s5); snapToZero(s6); snapToZero(s7);
+
+            state[S::lowMidS1][ch] = s0; state[S::lowMidS2][ch] = s1;
+            state[S::lowMidLowS3][ch] = s2; state[S::lowMidLowS4][ch] = s3;
+            state[S::midHighS1][ch] = s4; state[S::midHighS2][ch] = s5;
+            state[S::midHighLowS3][ch] = s6; state[S::midHighLowS4][ch] = s7;
+        }
+    }
+
+    //==============================================================================
+    static void compressBand(const DspStateArena::View& arena, int band, int numChannels, int numSamples) noexcept {
+        const auto& controls = *arena.controls;
+        const auto threshold = controls.threshold[band];
+        const auto thresholdInverse = controls.thresholdInverse[band];
+        const auto ratioExponent = controls.ratioExponent[band];
+        const auto attack = controls.attackCoeff[band];
+        const auto release = controls.releaseCoeff[band];
+
+        auto* envelope = arena.envelopeState + band * arena.channelStride;
+        auto* minGain = arena.minGain + band * arena.channelStride;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* x = arena.bandChannels[band * arena.numChannels + ch];
+            auto env = envelope[ch];
+            auto lowest = 1.0f;
+
+            for (int n = 0; n < numSamples; ++n) {
+                const auto in = x[n];
+                const auto rectified = absolute(in);
+                const auto cte = rectified > env ? attack : release;
+                env = rectified + cte * (env - rectified);
+
+                const auto gain = env < threshold ? 1.0f : ::powf(env * thresholdInverse, ratioExponent);
+                lowest = gain < lowest ? gain : lowest;
+                x[n] = gain * in;
+            }
+
+            snapToZero(env);
+            envelope[ch] = env;
+            minGain[ch] = lowest;
+        }
+    }
+
+    /** Same envelope, but the gain curve is only evaluated at the end of every interval
+        samples and ramped linearly from the previous value, so powf runs 1/interval as often.
+    */
+    static void compressBandControlRate(const DspStateArena::View& arena, int band, int interval,
+                                        int numChannels, int numSamples) noexcept {
+        const auto& controls = *arena.controls;
+        const auto threshold = controls.threshold[band];
+        const auto thresholdInverse = controls.thresholdInverse[band];
+        const auto ratioExponent = controls.ratioExponent[band];
+        const auto attack = controls.attackCoeff[band];
+        const auto release = controls.releaseCoeff[band];
+
+        auto* envelope = arena.envelopeState + band * arena.channelStride;
+        auto* detectorGain = arena.detectorGain + band * arena.channelStride;
+        auto* minGain = arena.minGain + band * arena.channelStride;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* x = arena.bandChannels[band * arena.numChannels + ch];
+            auto env = envelope[ch];
+            auto gain = detectorGain[ch];
+            auto lowest = gain;     // the ramps are linear, their ends are the extremes
+
+            for (int start = 0; start < numSamples; start += interval) {
+                const auto length = numSamples - start < interval ? numSamples - start : interval;
+                auto* block = x + start;
+
+                for (int n = 0; n < length; ++n) {
+                    const auto rectified = absolute(block[n]);
+                    const auto cte = rectified > env ? attack : release;
+                    env = rectified + cte * (env - rectified);
+                }
+
+                const auto target = env < threshold ? 1.0f : ::powf(env * thresholdInverse, ratioExponent);
+                const auto step = (target - gain) / (float)length;
+
+                for (int n = 0; n < length; ++n)
+                    block[n] *= gain + step * (float)(n + 1);
+
+                gain = target;
+                lowest = gain < lowest ? gain : lowest;
+            }
+
+            snapToZero(env);
+            envelope[ch] = env;
+            detectorGain[ch] = gain;
+            minGain[ch] = lowest;
+        }
+    }
+
+    static void compressBandOversampled(const DspStateArena::View& arena, int band, int numChannels, int numSamples) noexcept {
+        constexpr auto factor = DspStateArena::detectorOversampling;
+        constexpr auto taps = DspStateArena::detectorTaps;
+
+        const auto& controls = *arena.controls;
+        const auto threshold = controls.threshold[band];
+        const auto thresholdInverse = controls.thresholdInverse[band];
+        const auto ratioExponent = controls.ratioExponent[band];
+        const auto attack = controls.oversampledAttackCoeff[band];
+        const auto release = controls.oversampledReleaseCoeff[band];
+        const auto& interpolator = controls.detectorInterpolator;
+
+        auto* envelope = arena.envelopeState + band * arena.channelStride;
+        auto* history = arena.detectorHistory + band * taps * arena.channelStride;
+        auto* minGain = arena.minGain + band * arena.channelStride;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* x = arena.bandChannels[band * arena.numChannels + ch];
+            auto env = envelope[ch];
+            auto lowest = 1.0f;
+
+            // h[0] is the newest input.
+            float h[taps];
+            for (int k = 0; k < taps; ++k)
+                h[k] = history[k * arena.channelStride + ch];
+
+            for (int n = 0; n < numSamples; ++n) {
+                for (int k = taps - 1; k > 0; --k)
+                    h[k] = h[k - 1];
+                h[0] = x[n];
+
+                for (int phase = 0; phase < factor; ++phase) {
+                    auto interpolated = 0.0f;
+                    for (int k = 0; k < taps; ++k)
+                        interpolated += interpolator[phase][k] * h[k];
+
+                    const auto rectified = absolute(interpolated);
+                    const auto cte = rectified > env ? attack : release;
+                    env = rectified + cte * (env - rectified);
+                }
+
+                const auto gain = env < threshold ? 1.0f : ::powf(env * thresholdInverse, ratioExponent);
+                lowest = gain < lowest ? gain : lowest;
+                x[n] = gain * x[n];
+            }
+
+            snapToZero(env);
+            envelope[ch] = env;
+            minGain[ch] = lowest;
+
+            for (int k = 0; k < taps; ++k) {
+                snapToZero(h[k]);
+                history[k * arena.channelStride + ch] = h[k];
+            }
+        }
+    }
+
+    //==============================================================================
+    static void sumBands(const DspStateArena::View& arena, const bool* bandEnabled,
+                         float* const* output, int numChannels, int numSamples) noexcept {
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* out = output[ch];
+            auto first = true;
+
+            for (int band = 0; band < DspStateArena::numBands; ++band) {
+                if (!bandEnabled[band])
+                    continue;
+
+                const auto* src = arena.bandChannels[band * arena.numChannels + ch];
+
+                if (first) {
+                    for (int n = 0; n < numSamples; ++n)
+                        out[n] = src[n];
+                }
+                else {
+                    for (int n = 0; n < numSamples; ++n)
+                        out[n] += src[n];
+                }
+
+                first = false;
+            }
+
+            if (first) {
+                for (int n = 0; n < numSamples; ++n)
+                    out[n] = 0.0f;
+            }
+        }
+    }
+
+    //==============================================================================
+    static const KernelTable kernels{
+        JUCE_STRINGIFY(MBC_KERNEL_ISA),
+        applyGainRamp,
+        splitBands,
+        splitBandsComplementary,
+        compressBand,
+        compressBandControlRate,
+        compressBandOversampled,
+        sumBands
+    };
+}
+}
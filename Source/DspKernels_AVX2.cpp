@@ -0,0 +1,27 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX2.cpp
+    Created: 19 Oct 2026
+
+    AVX2 + FMA build of the DSP kernels. Needs the AVX2 compiler flag scheme
+    (/arch:AVX2, -mavx2 -mfma); without it the table is left out.
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if defined (__AVX2__) && (defined (__FMA__) || defined (_MSC_VER))
+ #define MBC_KERNEL_ISA avx2
+ #include "DspKernelsImpl.h"
+ #undef MBC_KERNEL_ISA
+#endif
+
+const DspKernels::KernelTable* DspKernels::getAvx2Kernels() noexcept {
+#if defined (__AVX2__) && (defined (__FMA__) || defined (_MSC_VER))
+    return &avx2::kernels;
+#else
+    return nullptr;
+#endif
+}
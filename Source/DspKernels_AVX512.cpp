@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    DspKernels_AVX512.cpp
+    Created: 19 Oct 2026
+
+    AVX-512 build of the DSP kernels. Needs the AVX512 compiler flag scheme
+    (/arch:AVX512, -mavx512f -mavx512vl -mfma); without it the table is left out.
+    The compiler may use any extension those flags enable, so it is only
+    selected on CPUs with F, VL, BW and DQ.
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if defined (__AVX512F__)
+ #define MBC_KERNEL_ISA avx512
+ #include "DspKernelsImpl.h"
+ #undef MBC_KERNEL_ISA
+#endif
+
+const DspKernels::KernelTable* DspKernels::getAvx512Kernels() noexcept {
+#if defined (__AVX512F__)
+    return &avx512::kernels;
+#else
+    return nullptr;
+#endif
+}
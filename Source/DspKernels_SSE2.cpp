@@ -0,0 +1,27 @@
+/*
+  ==============================================================================
+
+    DspKernels_SSE2.cpp
+    Created: 19 Oct 2026
+
+    SSE2 build of the DSP kernels. Baseline on x86-64, only needs its own
+    flags on 32-bit x86 (/arch:SSE2, -msse2).
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MBC_KERNEL_ISA sse2
+ #include "DspKernelsImpl.h"
+ #undef MBC_KERNEL_ISA
+#endif
+
+const DspKernels::KernelTable* DspKernels::getSse2Kernels() noexcept {
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+    return &sse2::kernels;
+#else
+    return nullptr;
+#endif
+}
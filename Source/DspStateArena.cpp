@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    DspStateArena.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DspStateArena.h"
+
+namespace {
+    size_t alignUp(size_t bytes) noexcept {
+        return (bytes + DspStateArena::cacheLineSize - 1) & ~(DspStateArena::cacheLineSize - 1);
+    }
+}
+
+void DspStateArena::allocate(int newNumChannels, int newMaxBlockSize) {
+
+    jassert(newNumChannels > 0 && newMaxBlockSize > 0);
+
+    // Shorter blocks fit the buffers there are: nothing moves, the state stays as it is.
+    if (newNumChannels == numChannels && newMaxBlockSize <= blockCapacity) {
+        maxBlockSize = newMaxBlockSize;
+        return;
+    }
+
+    // Keep coefficients and ramps across re-prepares, and the recursive state while the
+    // channels stay the same; the old block is only freed once they are copied over.
+    juce::HeapBlock<char, true> previousStorage;
+    previousStorage.swapWith(storage);
+
+    const auto previousControls = controls != nullptr ? *controls : Controls{};
+    const auto* previousState = reinterpret_cast<const char*>(crossoverState);
+    const auto* previousFadeState = reinterpret_cast<const char*>(fadeCrossoverState);
+    const auto keepState = previousState != nullptr && newNumChannels == numChannels;
+
+    numChannels = newNumChannels;
+    maxBlockSize = newMaxBlockSize;
+    blockCapacity = newMaxBlockSize;
+
+    // Per-channel state rows are packed back to back (a stereo instance's whole crossover
+    // state fits in two cache lines), only the sample buffers are padded for SIMD loads.
+    constexpr auto floatsPerLine = (int)(cacheLineSize / sizeof(float));
+    channelStride = numChannels;
+    const auto sampleStride = (size_t)(maxBlockSize + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+
+    // Layout follows processChunk: small control data first, then the per-channel
+    // recursive state, then the sample buffers that stream through the cache. The fade
+    // set is only touched while the split topology changes, so it goes last.
+    const auto controlsBytes = alignUp(sizeof(Controls));
+    const auto crossoverBytes = alignUp(sizeof(float) * (size_t)(numCrossoverStates * channelStride));
+    const auto envelopeBytes = alignUp(sizeof(float) * (size_t)(numBands * channelStride));
+    const auto historyBytes = alignUp(sizeof(float) * (size_t)(numBands * detectorTaps * channelStride));
+    const auto pointerBytes = alignUp(sizeof(float*) * (size_t)(numBands * numChannels));
+    const auto scratchBytes = alignUp(sizeof(float) * sampleStride);
+    const auto bandBytes = sizeof(float) * sampleStride * (size_t)(numBands * numChannels);
+
+    sizeInBytes = controlsBytes + crossoverBytes + 3 * envelopeBytes + historyBytes + pointerBytes + scratchBytes
+                + bandBytes + crossoverBytes + pointerBytes + bandBytes;
+
+    storage.allocate(sizeInBytes + cacheLineSize, true);
+
+    auto* base = reinterpret_cast<char*>(alignUp(reinterpret_cast<size_t>(storage.get())));
+
+    controls = new (base) Controls(previousControls);
+    base += controlsBytes;
+
+    crossoverState = reinterpret_cast<float*>(base);
+    base += crossoverBytes;
+
+    envelopeState = reinterpret_cast<float*>(base);
+    base += envelopeBytes;
+
+    detectorGain = reinterpret_cast<float*>(base);
+    base += envelopeBytes;
+
+    detectorHistory = reinterpret_cast<float*>(base);
+    base += historyBytes;
+
+    // Written by every compressor call, read by the meters; not state that needs keeping.
+    minGain = reinterpret_cast<float*>(base);
+    base += envelopeBytes;
+
+    bandChannels = reinterpret_cast<float**>(base);
+    base += pointerBytes;
+
+    gainScratch = reinterpret_cast<float*>(base);
+    base += scratchBytes;
+
+    auto* bandData = reinterpret_cast<float*>(base);
+    for (int i = 0; i < numBands * numChannels; ++i)
+        bandChannels[i] = bandData + (size_t)i * sampleStride;
+    base += bandBytes;
+
+    fadeCrossoverState = reinterpret_cast<float*>(base);
+    base += crossoverBytes;
+
+    fadeBandChannels = reinterpret_cast<float**>(base);
+    base += pointerBytes;
+
+    auto* fadeBandData = reinterpret_cast<float*>(base);
+    for (int i = 0; i < numBands * numChannels; ++i)
+        fadeBandChannels[i] = fadeBandData + (size_t)i * sampleStride;
+
+    // The recursive state rows come first and back to back, so they copy as one block.
+    const auto stateBytes = crossoverBytes + 2 * envelopeBytes + historyBytes;
+
+    if (keepState) {
+        std::memcpy(crossoverState, previousState, stateBytes);
+        std::memcpy(fadeCrossoverState, previousFadeState, crossoverBytes);
+        std::fill(minGain, minGain + numBands * channelStride, 1.0f);
+    } else {
+        clearState();
+    }
+}
+
+void DspStateArena::clearState() noexcept {
+    if (crossoverState == nullptr)
+        return;
+
+    std::fill(crossoverState, crossoverState + numCrossoverStates * channelStride, 0.0f);
+    std::fill(envelopeState, envelopeState + numBands * channelStride, 0.0f);
+    std::fill(detectorGain, detectorGain + numBands * channelStride, 1.0f);
+    std::fill(detectorHistory, detectorHistory + numBands * detectorTaps * channelStride, 0.0f);
+    std::fill(minGain, minGain + numBands * channelStride, 1.0f);
+    std::fill(fadeCrossoverState, fadeCrossoverState + numCrossoverStates * channelStride, 0.0f);
+}
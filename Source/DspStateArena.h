@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    DspStateArena.h
+    Created: 19 Oct 2026
+
+    All per-instance DSP state (gain ramps, crossover and compressor
+    coefficients, filter and envelope state, band buffers) in one
+    cache-line-aligned allocation made in prepareToPlay.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class DspStateArena {
+public:
+    static constexpr int numBands = 3;
+    static constexpr int maxChannels = 32;
+    static constexpr size_t cacheLineSize = 64;
+
+    // The high-quality detector looks for peaks between the samples: it runs on the band
+    // interpolated to detectorOversampling times the rate, detectorTaps taps per phase.
+    static constexpr int detectorOversampling = 4;
+    static constexpr int detectorTaps = 8;
+
+    /** Per-channel crossover state, stored struct-of-arrays: each entry is a row of numChannels floats.
+        LP1/HP1 and LP2/HP2 see the same input, so their identical first TPT stage is kept only once.
+    */
+    enum CrossoverState {
+        lowMidS1,       // fc0, shared first stage
+        lowMidS2,
+        lowMidLowS3,    // fc0, LP1 second stage
+        lowMidLowS4,
+        lowMidHighS3,   // fc0, HP1 second stage
+        lowMidHighS4,
+        allPassS1,      // fc1, AP2 on the low band
+        allPassS2,
+        midHighS1,      // fc1, shared first stage
+        midHighS2,
+        midHighLowS3,   // fc1, LP2 second stage
+        midHighLowS4,
+        midHighHighS3,  // fc1, HP2 second stage
+        midHighHighS4,
+
+        numCrossoverStates
+    };
+
+    /** Linear ramp, same behaviour as juce::SmoothedValue<float, Linear>. */
+    struct GainRamp {
+        float current{ 0 };
+        float target{ 0 };
+        float step{ 0 };
+        int countdown{ 0 };
+        int stepsToTarget{ 0 };
+    };
+
+    /** Linkwitz-Riley TPT coefficients, same as juce::dsp::LinkwitzRileyFilter. */
+    struct CrossoverCoeffs {
+        float g{ 0 };
+        float h{ 0 };
+        float R2{ 0 };
+        float R2PlusG{ 0 };
+    };
+
+    /** Everything the hot loop reads that is not per channel, in the order it reads it. */
+    struct alignas(cacheLineSize) Controls {
+        double sampleRate{ 44100.0 };
+
+        GainRamp inputGain;
+
+        CrossoverCoeffs lowMid;
+        CrossoverCoeffs midHigh;
+
+        float threshold[numBands]{};
+        float thresholdInverse[numBands]{};
+        float ratioExponent[numBands]{};    // 1 / ratio - 1
+        float attackCoeff[numBands]{};
+        float releaseCoeff[numBands]{};
+
+        // Same time constants at the oversampled detector's rate.
+        float oversampledAttackCoeff[numBands]{};
+        float oversampledReleaseCoeff[numBands]{};
+        float detectorInterpolator[detectorOversampling][detectorTaps]{};
+
+        GainRamp outputGain;
+    };
+
+    /** Plain pointers into the arena, which is all the per-ISA kernels get to see. */
+    struct View {
+        Controls* controls;
+        float* crossoverState;
+        float* envelopeState;
+        float* detectorGain;            // last gain of the control-rate compressor, per band row
+        float* detectorHistory;         // band inputs seen by the interpolator, [band * detectorTaps + tap] rows
+        float* minGain;                 // lowest gain of the last compressor call, per band row
+        float* gainScratch;
+        float* const* bandChannels;     // [band * numChannels + channel]
+        int numChannels;
+        int channelStride;
+    };
+
+    DspStateArena() = default;
+
+    /** Lays out and allocates the arena. Call from prepareToPlay only. Blocks no longer than
+        the arena was laid out for reuse it as it is; with the same number of channels the
+        filter and envelope state survive either way, clearState() starts them over.
+    */
+    void allocate(int numChannels, int maxBlockSize);
+
+    /** Zeros filter and envelope state (detector and minimum gains go to unity), leaves the coefficients alone. */
+    void clearState() noexcept;
+
+    Controls& getControls() noexcept { return *controls; }
+    const Controls& getControls() const noexcept { return *controls; }
+
+    float* getCrossoverState(int state) noexcept { return crossoverState + state * channelStride; }
+    float* getEnvelopeState(int band) noexcept { return envelopeState + band * channelStride; }
+    float* getDetectorGain(int band) noexcept { return detectorGain + band * channelStride; }
+    float* getDetectorHistory(int band) noexcept { return detectorHistory + band * detectorTaps * channelStride; }
+    float* getMinGain(int band) noexcept { return minGain + band * channelStride; }
+    const float* getMinGain(int band) const noexcept { return minGain + band * channelStride; }
+    float* getGainScratch() noexcept { return gainScratch; }
+
+    float* getBandChannel(int band, int channel) noexcept { return bandChannels[band * numChannels + channel]; }
+    float* const* getBandChannels(int band) noexcept { return bandChannels + band * numChannels; }
+
+    /** Second set of crossover state and band buffers, for crossfading between split topologies. */
+    float* getFadeCrossoverState(int state) noexcept { return fadeCrossoverState + state * channelStride; }
+    float* getFadeBandChannel(int band, int channel) noexcept { return fadeBandChannels[band * numChannels + channel]; }
+
+    View getView() noexcept {
+        return { controls, crossoverState, envelopeState, detectorGain, detectorHistory, minGain, gainScratch,
+                 bandChannels, numChannels, channelStride };
+    }
+
+    /** Channels first to first + count only, for running channel groups on separate threads.
+        bandChannelStorage holds the group's band pointers, numBands * count of them.
+        The gain scratch is shared: gain ramps can't be split by channel.
+    */
+    View getView(int first, int count, float** bandChannelStorage) noexcept {
+        return makeView(crossoverState, bandChannels, first, count, bandChannelStorage);
+    }
+
+    /** Same channels, running on the fade crossover state into the fade band buffers. */
+    View getFadeView(int first, int count, float** bandChannelStorage) noexcept {
+        return makeView(fadeCrossoverState, fadeBandChannels, first, count, bandChannelStorage);
+    }
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int getMaxBlockSize() const noexcept { return maxBlockSize; }
+    size_t getSizeInBytes() const noexcept { return sizeInBytes; }
+
+private:
+    View makeView(float* crossover, float* const* bands, int first, int count, float** bandChannelStorage) noexcept {
+        jassert(first >= 0 && count > 0 && first + count <= numChannels);
+
+        for (int band = 0; band < numBands; ++band)
+            for (int ch = 0; ch < count; ++ch)
+                bandChannelStorage[band * count + ch] = bands[band * numChannels + first + ch];
+
+        return { controls, crossover + first, envelopeState + first, detectorGain + first, detectorHistory + first,
+                 minGain + first, gainScratch, bandChannelStorage, count, channelStride };
+    }
+
+    juce::HeapBlock<char, true> storage;     // throws std::bad_alloc, see mbc_prepare
+    size_t sizeInBytes{ 0 };
+
+    int numChannels{ 0 };
+    int maxBlockSize{ 0 };
+    int blockCapacity{ 0 };     // the block size the sample buffers were laid out for
+    int channelStride{ 0 };
+
+    Controls* controls{ nullptr };
+    float* crossoverState{ nullptr };
+    float* envelopeState{ nullptr };
+    float* detectorGain{ nullptr };
+    float* detectorHistory{ nullptr };
+    float* minGain{ nullptr };
+    float* gainScratch{ nullptr };
+    float** bandChannels{ nullptr };
+
+    float* fadeCrossoverState{ nullptr };
+    float** fadeBandChannels{ nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE(DspStateArena)
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    DspTaskPool.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DspTaskPool.h"
+
+#include <thread>
+
+class DspTaskPool::Worker : public juce::Thread {
+public:
+    explicit Worker(DspTaskPool& p) : juce::Thread("DspTaskPool"), pool(p) {}
+
+    ~Worker() override {
+        signalThreadShouldExit();
+        wake.signal();
+        stopThread(2000);
+    }
+
+    void run() override {
+        while (!threadShouldExit()) {
+            wake.wait(100);
+
+            const auto job = pool.generation.load(std::memory_order_acquire);
+            if (job == finishedJob.load(std::memory_order_relaxed))
+                continue;
+
+            pool.work();
+            finishedJob.store(job, std::memory_order_release);
+        }
+    }
+
+    // run() signals it from the audio thread, which mustn't take a lock.
+    WakeSemaphore wake;
+    std::atomic<juce::uint32> finishedJob{ 0 };
+
+private:
+    DspTaskPool& pool;
+};
+
+//==============================================================================
+DspTaskPool::DspTaskPool(int numThreads) {
+    for (int i = 1; i < numThreads; ++i) {
+        workers.push_back(std::make_unique<Worker>(*this));
+        workers.back()->startThread();
+    }
+}
+
+DspTaskPool::~DspTaskPool() {
+    workers.clear();
+}
+
+void DspTaskPool::run(TaskFunction functionToRun, void* contextToUse, const int* tasks, int phases) noexcept {
+    jassert(phases <= maxPhases);
+
+    // Every worker has finished the previous job (see the end of this function),
+    // so nobody reads these while they change.
+    function = functionToRun;
+    context = contextToUse;
+    numPhases = juce::jmin(phases, maxPhases);
+
+    for (int p = 0; p < numPhases; ++p) {
+        numTasks[p] = tasks[p];
+        nextTask[p].store(0, std::memory_order_relaxed);
+        numTasksDone[p].store(0, std::memory_order_relaxed);
+    }
+
+    const auto job = generation.load(std::memory_order_relaxed) + 1;
+    generation.store(job, std::memory_order_release);
+
+    for (auto& w : workers)
+        w->wake.signal();
+
+    work();
+
+    // All tasks are done here, but a worker may still be on its way out of work().
+    for (auto& w : workers)
+        while (w->finishedJob.load(std::memory_order_acquire) != job)
+            std::this_thread::yield();
+}
+
+void DspTaskPool::work() noexcept {
+    for (int p = 0; p < numPhases; ++p) {
+        for (;;) {
+            const auto task = nextTask[p].fetch_add(1, std::memory_order_relaxed);
+            if (task >= numTasks[p])
+                break;
+
+            function(context, p, task);
+            numTasksDone[p].fetch_add(1, std::memory_order_release);
+        }
+
+        // Barrier: the next phase reads what this one wrote.
+        while (numTasksDone[p].load(std::memory_order_acquire) < numTasks[p])
+            std::this_thread::yield();
+    }
+}
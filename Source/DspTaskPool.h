@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    DspTaskPool.h
+    Created: 19 Oct 2026
+
+    Worker threads for splitting one DspEngine chunk across cores in offline
+    renders. A job is a few phases of independent tasks; every thread,
+    the caller included, takes the next task of the current phase from an
+    atomic counter until none are left, then waits at the phase's barrier
+    (a completion counter, spun on) before moving to the next phase.
+    Handing a job over only signals a WakeSemaphore per worker, so run() takes
+    no lock and may be called inside processBlock.
+
+    Which thread runs a task doesn't change what it computes, so the result
+    is the same as running the tasks one after the other.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "WakeSemaphore.h"
+
+class DspTaskPool {
+public:
+    static constexpr int maxPhases = 4;
+
+    /** Runs task number task of phase phase. Must not throw. */
+    using TaskFunction = void (*)(void* context, int phase, int task);
+
+    /** numThreads counts the caller, so numThreads - 1 workers are started. */
+    explicit DspTaskPool(int numThreads);
+    ~DspTaskPool();
+
+    int getNumThreads() const noexcept { return (int)workers.size() + 1; }
+
+    /** Runs every task of numTasks[0], then of numTasks[1], and so on, returning when all
+        are done. One job at a time: don't call from two threads at once.
+    */
+    void run(TaskFunction function, void* context, const int* numTasks, int numPhases) noexcept;
+
+private:
+    class Worker;
+
+    void work() noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // The current job, written by run() before it publishes the job's generation.
+    TaskFunction function{ nullptr };
+    void* context{ nullptr };
+    int numPhases{ 0 };
+    int numTasks[maxPhases]{};
+
+    alignas(64) std::atomic<juce::uint32> generation{ 0 };
+    alignas(64) std::atomic<int> nextTask[maxPhases]{};
+    alignas(64) std::atomic<int> numTasksDone[maxPhases]{};
+
+    JUCE_DECLARE_NON_COPYABLE(DspTaskPool)
+};
@@ -0,0 +1,479 @@
+/*
+  ==============================================================================
+
+    EquivalenceHarness.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "EquivalenceHarness.h"
+#include "ChainSettings.h"
+#include "DspKernels.h"
+#include "PluginProcessor.h"
+#include "ReferenceChain.h"
+
+namespace {
+
+    struct ParameterChange {
+        int parameterIndex;
+        float normalisedValue;
+    };
+
+    using Automation = std::vector<std::vector<ParameterChange>>;   // per host block
+
+    std::vector<int> makeBlockPattern(int blockSize, int totalSamples, juce::Random& random, int maxRandomSize) {
+        std::vector<int> sizes;
+        for (int done = 0; done < totalSamples;) {
+            const auto size = juce::jmin(totalSamples - done, blockSize > 0 ? blockSize : 1 + random.nextInt(maxRandomSize));
+            sizes.push_back(size);
+            done += size;
+        }
+        return sizes;
+    }
+
+    Automation makeAutomation(size_t numBlocks, int numParameters, double probability, juce::Random& random) {
+        Automation automation(numBlocks);
+        for (auto& changes : automation) {
+            if (random.nextDouble() >= probability)
+                continue;
+
+            for (int i = 1 + random.nextInt(3); --i >= 0;)
+                changes.push_back({ random.nextInt(numParameters), random.nextFloat() });
+        }
+        return automation;
+    }
+
+    void applyChanges(juce::AudioProcessor& processor, const std::vector<ParameterChange>& changes) {
+        const auto& parameters = processor.getParameters();
+        for (auto& change : changes)
+            parameters[change.parameterIndex]->setValueNotifyingHost(change.normalisedValue);
+    }
+
+    /** Audio of one host block, pointing into a bigger buffer. */
+    juce::AudioBuffer<float> blockOf(juce::AudioBuffer<float>& audio, int start, int numSamples) {
+        return juce::AudioBuffer<float>(audio.getArrayOfWritePointers(), audio.getNumChannels(), start, numSamples);
+    }
+
+    void compare(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& optimised,
+                 EquivalenceHarness::Result& result) {
+        double maxError = 0, errorEnergy = 0, referenceEnergy = 0, optimisedEnergy = 0;
+
+        for (int ch = 0; ch < reference.getNumChannels(); ++ch) {
+            const auto* r = reference.getReadPointer(ch);
+            const auto* o = optimised.getReadPointer(ch);
+
+            for (int n = 0; n < reference.getNumSamples(); ++n) {
+                const auto error = (double)o[n] - (double)r[n];
+                maxError = juce::jmax(maxError, std::abs(error));
+                errorEnergy += error * error;
+                referenceEnergy += (double)r[n] * r[n];
+                optimisedEnergy += (double)o[n] * o[n];
+            }
+        }
+
+        const auto numValues = (double)juce::jmax(1, reference.getNumChannels() * reference.getNumSamples());
+
+        result.maxError = maxError;
+        result.rmsError = std::sqrt(errorEnergy / numValues);
+        result.nullDepthDb = errorEnergy > 0 ? 10.0 * std::log10(referenceEnergy / errorEnergy)
+                                             : std::numeric_limits<double>::infinity();
+        result.levelDifferenceDb = referenceEnergy > 0 && optimisedEnergy > 0
+                                 ? 10.0 * std::log10(optimisedEnergy / referenceEnergy)
+                                 : (referenceEnergy == optimisedEnergy ? 0.0 : std::numeric_limits<double>::infinity());
+    }
+}
+
+//==============================================================================
+std::vector<EquivalenceHarness::Mode> EquivalenceHarness::getModes() {
+    std::vector<Mode> modes;
+
+    // Same operations as the reference, only the order of evaluation may differ.
+    const Bounds exact{ 1.0e-5, 1.0e-6, 110.0, 0.01 };
+    // FMA contraction changes the rounding inside the IIR recursions.
+    const Bounds fused{ 1.0e-4, 1.0e-5, 90.0, 0.01 };
+
+    for (int i = 0; i < (int)DspKernels::Isa::numIsas; ++i) {
+        const auto isa = (DspKernels::Isa)i;
+        const auto usesFma = isa == DspKernels::Isa::avx2 || isa == DspKernels::Isa::avx512;
+        const auto previous = std::make_shared<DspKernels::Isa>();
+
+        modes.push_back({ juce::String("kernels/") + DspKernels::getIsaName(isa),
+                          usesFma ? fused : exact,
+                          [isa, previous] { *previous = DspKernels::getActiveIsa(); return DspKernels::forceIsa(isa); },
+                          [previous] { DspKernels::forceIsa(*previous); } });
+    }
+
+    // The QualityGovernor's cheaper tiers, each held for the whole run. A decimated detector
+    // interpolates the gain, which lags the reference's on fast attacks and parameter jumps.
+    const Bounds tierBounds[] = {
+        {},
+        { 0.5, 0.01, 25.0, 0.5 },       // detector / 4
+        { 0.6, 0.02, 20.0, 0.5 },       // detector / 16
+        // The complementary split sums to the input where the LR4 split sums to an allpass:
+        // the same magnitude (1e-4 dB apart as measured) with a different phase, so it can't
+        // null. Its accuracy bound is on that magnitude. Compressed, its bands have other
+        // shapes than LR4 bands and the compressors react to them differently by design;
+        // on the automated runs the other bounds only guard against a blow-up.
+        { 2.0, 0.5, -12.0, 6.0, 0.01 }
+    };
+
+    for (int tier = QualityGovernor::detectorEvery4; tier < QualityGovernor::numTiers; ++tier) {
+        modes.push_back({ juce::String("tier/") + QualityGovernor::getTierName(tier), tierBounds[tier], {}, {},
+                          [tier](Multiband_compAudioProcessor& processor) { processor.setFixedQualityTier(tier); } });
+    }
+
+    // Switching between the LR4 and the complementary split every quarter second, through the crossfade.
+    // Mid-fade the two sums partly cancel where their phases differ, so only the blow-up guard applies.
+    auto splitFadeBounds = tierBounds[QualityGovernor::complementary];
+    splitFadeBounds.maxMagnitudeErrorDb = std::numeric_limits<double>::infinity();
+
+    modes.push_back({ "tier/split fade", splitFadeBounds, {}, {}, {},
+                      [](Multiband_compAudioProcessor& processor, int start) {
+                          const auto period = juce::roundToInt(0.25 * processor.getSampleRate());
+                          processor.setFixedQualityTier((start / period) % 2 == 0 ? QualityGovernor::full
+                                                                                   : QualityGovernor::complementary);
+                      } });
+
+    // What a bounce runs: the oversampled detector also reacts to inter-sample peaks, so it
+    // reduces a little more than the reference on transients and high frequencies.
+    modes.push_back({ "render", { 0.5, 0.01, 15.0, 1.0 }, {}, {},
+                      [](Multiband_compAudioProcessor& processor) {
+                          processor.setNonRealtime(true);
+                          processor.setMaxRenderThreads(1);
+                      } });
+
+    // The same render spread over worker threads must be bit-identical to it.
+    modes.push_back({ "render/parallel", { 0.0, 0.0, std::numeric_limits<double>::infinity(), 0.0 }, {}, {},
+                      [](Multiband_compAudioProcessor& processor) {
+                          processor.setNonRealtime(true);
+                          processor.setMaxRenderThreads(4);
+                      },
+                      {}, "render" });
+
+    return modes;
+}
+
+std::vector<EquivalenceHarness::Signal> EquivalenceHarness::makeSyntheticSignals(const Options& options) {
+    const auto numSamples = (int)(options.lengthSeconds * options.sampleRate);
+    const auto sampleRate = options.sampleRate;
+    juce::Random random(options.seed);
+
+    auto make = [&](const juce::String& name, auto&& generator) {
+        Signal signal{ name, juce::AudioBuffer<float>(options.numChannels, numSamples) };
+        for (int ch = 0; ch < options.numChannels; ++ch)
+            for (int n = 0; n < numSamples; ++n)
+                signal.audio.setSample(ch, n, generator(ch, n));
+        return signal;
+    };
+
+    std::vector<Signal> signals;
+
+    signals.push_back(make("log sweep 20Hz-20kHz", [&](int, int n) {
+        const auto duration = numSamples / sampleRate;
+        const auto k = std::log(20000.0 / 20.0);
+        const auto t = n / sampleRate;
+        const auto phase = juce::MathConstants<double>::twoPi * 20.0 * duration / k * (std::exp(t / duration * k) - 1.0);
+        return (float)(0.5 * std::sin(phase));
+    }));
+
+    signals.push_back(make("white noise", [&](int, int) {
+        return (random.nextFloat() * 2.0f - 1.0f) * 0.25f;
+    }));
+
+    signals.push_back(make("impulses", [&](int ch, int n) {
+        return n % 4801 == ch * 7 ? 1.0f : 0.0f;
+    }));
+
+    // Loud burst followed by silence: drives the filter and envelope state towards denormals.
+    signals.push_back(make("burst then silence", [&](int, int n) {
+        return n < (int)(0.1 * sampleRate) ? (random.nextFloat() * 2.0f - 1.0f) : 0.0f;
+    }));
+
+    return signals;
+}
+
+juce::Result EquivalenceHarness::loadSignals(const Options& options, std::vector<Signal>& signals) {
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    juce::StringArray unreadable;
+
+    for (auto& file : options.realSignals) {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr) {
+            unreadable.add(file.getFullPathName());
+            continue;
+        }
+
+        const auto numSamples = (int)juce::jmin(reader->lengthInSamples, (juce::int64)(options.lengthSeconds * options.sampleRate));
+        Signal signal{ file.getFileName(), juce::AudioBuffer<float>(options.numChannels, numSamples) };
+
+        // Mono files go to every channel; the file's own sample rate is ignored, equivalence doesn't care.
+        reader->read(&signal.audio, 0, numSamples, 0, true, true);
+        for (int ch = (int)reader->numChannels; ch < options.numChannels; ++ch)
+            signal.audio.copyFrom(ch, 0, signal.audio, 0, 0, numSamples);
+
+        signals.push_back(std::move(signal));
+    }
+
+    return unreadable.isEmpty() ? juce::Result::ok()
+                                : juce::Result::fail("can't read " + unreadable.joinIntoString(", "));
+}
+
+//==============================================================================
+std::vector<EquivalenceHarness::Result> EquivalenceHarness::run(const Options& options) const {
+    std::vector<Result> results;
+
+    auto signals = makeSyntheticSignals(options);
+    const auto loaded = loadSignals(options, signals);
+
+    // A recording that was asked for but not checked fails the run.
+    if (loaded.failed()) {
+        Result result;
+        result.mode = "recordings";
+        result.error = loaded.getErrorMessage();
+        results.push_back(result);
+    }
+
+    std::vector<int> patterns(options.blockSizes);
+    for (int i = 0; i < options.numRandomBlockPatterns; ++i)
+        patterns.push_back(0);
+
+    const auto modes = getModes();
+    juce::Random random(options.seed);
+
+    for (auto& mode : modes)
+        if (std::isfinite(mode.bounds.maxMagnitudeErrorDb))
+            results.push_back(measureSplit(mode, options));
+
+    for (auto& signal : signals) {
+        const auto numSamples = signal.audio.getNumSamples();
+
+        for (auto blockSize : patterns) {
+            const auto sizes = makeBlockPattern(blockSize, numSamples, random, 4 * options.preparedBlockSize);
+            const auto blocksName = blockSize > 0 ? juce::String(blockSize) : juce::String("random");
+
+            // The same automation is replayed on the reference and on every mode.
+            Multiband_compAudioProcessor parameterHost;
+            const auto automation = makeAutomation(sizes.size(), parameterHost.getParameters().size(),
+                                                   options.automationProbability, random);
+
+            std::vector<ChainSettings> settings;
+            for (auto& changes : automation) {
+                applyChanges(parameterHost, changes);
+                settings.push_back(ChainSettings::fromParameters(parameterHost.apvts));
+            }
+
+            // Reference, fed the host blocks as they are.
+            juce::AudioBuffer<float> reference(signal.audio);
+            {
+                ReferenceChain chain;
+                chain.prepare(options.sampleRate, options.numChannels, options.preparedBlockSize);
+
+                int start = 0;
+                for (size_t b = 0; b < sizes.size(); ++b) {
+                    juce::AudioBuffer<float> block(options.numChannels, sizes[b]);
+                    for (int ch = 0; ch < options.numChannels; ++ch)
+                        block.copyFrom(ch, 0, reference, ch, start, sizes[b]);
+
+                    chain.process(block, settings[b]);
+
+                    for (int ch = 0; ch < options.numChannels; ++ch)
+                        reference.copyFrom(ch, start, block, ch, 0, sizes[b]);
+                    start += sizes[b];
+                }
+            }
+
+            std::map<juce::String, juce::AudioBuffer<float>> outputs;     // by mode, for the baselines
+
+            for (auto& mode : modes) {
+                Result result;
+                result.mode = mode.name;
+                result.signal = signal.name;
+                result.blocks = blocksName;
+
+                if (mode.baseline.isNotEmpty() && outputs.count(mode.baseline) == 0) {
+                    result.error = "baseline " + mode.baseline + " didn't run";
+                    results.push_back(result);
+                    continue;
+                }
+
+                if (mode.enable && !mode.enable()) {
+                    result.skipped = true;
+                    results.push_back(result);
+                    continue;
+                }
+
+                juce::AudioBuffer<float> optimised(signal.audio);
+                {
+                    Multiband_compAudioProcessor processor;
+                    processor.setAdaptiveQuality(false);    // the reference has no cheaper tiers
+                    if (mode.configure)
+                        mode.configure(processor);
+                    processor.setPlayConfigDetails(options.numChannels, options.numChannels,
+                                                   options.sampleRate, options.preparedBlockSize);
+                    processor.prepareToPlay(options.sampleRate, options.preparedBlockSize);
+
+                    juce::MidiBuffer midi;
+                    int start = 0;
+                    for (size_t b = 0; b < sizes.size(); ++b) {
+                        applyChanges(processor, automation[b]);
+                        if (mode.beforeBlock)
+                            mode.beforeBlock(processor, start);
+
+                        auto block = blockOf(optimised, start, sizes[b]);
+                        processor.processBlock(block, midi);
+                        start += sizes[b];
+                    }
+
+                    processor.releaseResources();
+                }
+
+                if (mode.disable)
+                    mode.disable();
+
+                compare(mode.baseline.isEmpty() ? reference : outputs[mode.baseline], optimised, result);
+                outputs[mode.name] = std::move(optimised);
+
+                result.passed = result.maxError <= mode.bounds.maxError
+                             && result.rmsError <= mode.bounds.rmsError
+                             && result.nullDepthDb >= mode.bounds.minNullDepthDb
+                             && std::abs(result.levelDifferenceDb) <= mode.bounds.maxLevelDifferenceDb;
+
+                results.push_back(result);
+            }
+        }
+    }
+
+    return results;
+}
+
+EquivalenceHarness::Result EquivalenceHarness::measureSplit(const Mode& mode, const Options& options) {
+    // An impulse once the gains have faded in, then long enough for the lowest crossover's
+    // allpass to ring out.
+    constexpr int fftOrder = 15;
+    constexpr int length = 1 << fftOrder;
+    const auto impulseAt = juce::roundToInt(0.1 * options.sampleRate);
+    const auto numSamples = impulseAt + length;
+
+    Result result;
+    result.mode = mode.name;
+    result.signal = "split impulse";
+    result.blocks = juce::String(options.preparedBlockSize);
+
+    if (mode.enable && !mode.enable()) {
+        result.skipped = true;
+        return result;
+    }
+
+    juce::AudioBuffer<float> impulse(options.numChannels, numSamples);
+    impulse.clear();
+    for (int ch = 0; ch < options.numChannels; ++ch)
+        impulse.setSample(ch, impulseAt, 1.0f);
+
+    juce::AudioBuffer<float> reference(impulse), optimised(impulse);
+
+    ChainSettings settings;
+    for (auto& band : settings.bands)
+        band.bypassed = true;
+
+    {
+        ReferenceChain chain;
+        chain.prepare(options.sampleRate, options.numChannels, options.preparedBlockSize);
+
+        for (int start = 0; start < numSamples; start += options.preparedBlockSize) {
+            auto block = blockOf(reference, start, juce::jmin(options.preparedBlockSize, numSamples - start));
+            chain.process(block, settings);
+        }
+    }
+
+    {
+        Multiband_compAudioProcessor processor;
+        processor.setAdaptiveQuality(false);
+        if (mode.configure)
+            mode.configure(processor);
+
+        for (auto name : { Params::Bypassed_Low_Band, Params::Bypassed_Mid_Band, Params::Bypassed_High_Band })
+            processor.apvts.getParameter(Params::GetParams().at(name))->setValueNotifyingHost(1.0f);
+
+        processor.setPlayConfigDetails(options.numChannels, options.numChannels,
+                                       options.sampleRate, options.preparedBlockSize);
+        processor.prepareToPlay(options.sampleRate, options.preparedBlockSize);
+
+        juce::MidiBuffer midi;
+        for (int start = 0; start < numSamples; start += options.preparedBlockSize) {
+            auto block = blockOf(optimised, start, juce::jmin(options.preparedBlockSize, numSamples - start));
+            processor.processBlock(block, midi);
+        }
+
+        processor.releaseResources();
+    }
+
+    if (mode.disable)
+        mode.disable();
+
+    compare(reference, optimised, result);
+
+    // Magnitude spectra of the impulse responses, bin by bin.
+    juce::dsp::FFT fft(fftOrder);
+    std::vector<float> referenceSpectrum((size_t)(2 * length)), optimisedSpectrum((size_t)(2 * length));
+    const auto firstBin = (int)std::ceil(20.0 * length / options.sampleRate);
+    const auto lastBin = (int)std::floor(juce::jmin(20000.0, 0.5 * options.sampleRate) * length / options.sampleRate);
+
+    for (int ch = 0; ch < options.numChannels; ++ch) {
+        std::fill(referenceSpectrum.begin(), referenceSpectrum.end(), 0.0f);
+        std::fill(optimisedSpectrum.begin(), optimisedSpectrum.end(), 0.0f);
+        std::copy_n(reference.getReadPointer(ch, impulseAt), length, referenceSpectrum.begin());
+        std::copy_n(optimised.getReadPointer(ch, impulseAt), length, optimisedSpectrum.begin());
+
+        fft.performFrequencyOnlyForwardTransform(referenceSpectrum.data());
+        fft.performFrequencyOnlyForwardTransform(optimisedSpectrum.data());
+
+        for (int bin = firstBin; bin <= lastBin; ++bin) {
+            const auto error = juce::Decibels::gainToDecibels((double)optimisedSpectrum[(size_t)bin], -200.0)
+                             - juce::Decibels::gainToDecibels((double)referenceSpectrum[(size_t)bin], -200.0);
+            result.magnitudeErrorDb = juce::jmax(result.magnitudeErrorDb, std::abs(error));
+        }
+    }
+
+    result.passed = result.magnitudeErrorDb <= mode.bounds.maxMagnitudeErrorDb;
+    return result;
+}
+
+bool EquivalenceHarness::allPassed(const std::vector<Result>& results) {
+    return std::all_of(results.begin(), results.end(), [](const Result& r) { return r.skipped || r.passed; });
+}
+
+juce::String EquivalenceHarness::formatReport(const std::vector<Result>& results) {
+    juce::String report;
+
+    auto column = [](const juce::String& text, int width) { return text.paddedRight(' ', width); };
+
+    report << column("mode", 26) << column("signal", 24) << column("blocks", 8)
+           << column("max err", 14) << column("rms err", 14) << column("null dB", 10) << column("level dB", 10)
+           << column("mag dB", 10) << "result" << juce::newLine;
+
+    for (auto& r : results) {
+        report << column(r.mode, 26) << column(r.signal, 24) << column(r.blocks, 8);
+
+        if (r.error.isNotEmpty()) {
+            report << "FAIL: " << r.error << juce::newLine;
+            continue;
+        }
+
+        if (r.skipped) {
+            report << "skipped (not available here)" << juce::newLine;
+            continue;
+        }
+
+        report << column(juce::String(r.maxError, 0, true), 14)
+               << column(juce::String(r.rmsError, 0, true), 14)
+               << column(std::isinf(r.nullDepthDb) ? juce::String("inf") : juce::String(r.nullDepthDb, 1), 10)
+               << column(juce::String(r.levelDifferenceDb, 2), 10)
+               << column(r.signal == "split impulse" ? juce::String(r.magnitudeErrorDb, 4) : juce::String(), 10)
+               << (r.passed ? "ok" : "FAIL") << juce::newLine;
+    }
+
+    return report;
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    EquivalenceHarness.h
+    Created: 19 Oct 2026
+
+    Runs the frozen ReferenceChain and Multiband_compAudioProcessor side by
+    side over the same signals, block partitions and random parameter
+    automation, once per optimised mode, and reports how far they drift apart.
+
+    A mode may only be enabled in production once it stays inside its Bounds.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class Multiband_compAudioProcessor;
+
+class EquivalenceHarness {
+public:
+    struct Bounds {
+        double maxError;        // peak |reference - optimised|
+        double rmsError;
+        double minNullDepthDb;  // reference energy over difference energy
+        double maxLevelDifferenceDb;    // |optimised energy over reference energy|, for modes that can't null
+
+        /** For splits that differ from the reference's in phase only: an extra run with every
+            band bypassed, checking the magnitude response of the summed bands (20 Hz - 20 kHz)
+            against the reference's. Not run when infinite.
+        */
+        double maxMagnitudeErrorDb{ std::numeric_limits<double>::infinity() };
+    };
+
+    /** One optimised configuration of the processor. enable() returns false when the mode
+        can't run on this machine or build; it is then reported as skipped, not failed.
+        configure() sets up each processor the mode renders with, before prepareToPlay, and
+        beforeBlock() runs ahead of every host block with the block's first sample.
+        Any of the four may be empty.
+
+        A mode with a baseline is measured against that earlier mode's output instead of
+        the ReferenceChain, for paths that must reproduce another one exactly.
+    */
+    struct Mode {
+        juce::String name;
+        Bounds bounds;
+        std::function<bool()> enable;
+        std::function<void()> disable;
+        std::function<void(Multiband_compAudioProcessor&)> configure;
+        std::function<void(Multiband_compAudioProcessor&, int)> beforeBlock;
+        juce::String baseline;
+    };
+
+    struct Signal {
+        juce::String name;
+        juce::AudioBuffer<float> audio;
+    };
+
+    struct Options {
+        double sampleRate{ 48000.0 };
+        int numChannels{ 2 };
+        int preparedBlockSize{ 512 };
+        double lengthSeconds{ 2.0 };
+
+        /** Fixed host block sizes to try; sizes above preparedBlockSize exercise the chunking. */
+        std::vector<int> blockSizes{ 1, 2, 3, 16, 61, 64, 256, 512, 1024, 4096 };
+        /** Extra runs where every host block has a random size between 1 and 4 * preparedBlockSize. */
+        int numRandomBlockPatterns{ 2 };
+
+        /** Chance per host block that one to three random parameters jump to a random value. */
+        double automationProbability{ 0.1 };
+        juce::int64 seed{ 1 };
+
+        /** Recordings to use on top of the synthetic signals. */
+        juce::Array<juce::File> realSignals;
+    };
+
+    struct Result {
+        juce::String mode;
+        juce::String signal;
+        juce::String blocks;
+
+        double maxError{ 0 };
+        double rmsError{ 0 };
+        double nullDepthDb{ 0 };
+        double levelDifferenceDb{ 0 };
+        double magnitudeErrorDb{ 0 };   // the bypassed-band run only
+
+        bool skipped{ false };
+        bool passed{ false };
+
+        /** Set when the run couldn't happen at all, e.g. a recording that can't be read. */
+        juce::String error;
+    };
+
+    /** Every optimised path the processor has, with its accuracy bounds. */
+    static std::vector<Mode> getModes();
+
+    static std::vector<Signal> makeSyntheticSignals(const Options& options);
+    /** Appends the recordings; fails naming those it couldn't read, after loading the rest. */
+    static juce::Result loadSignals(const Options& options, std::vector<Signal>& signals);
+
+    std::vector<Result> run(const Options& options) const;
+
+    /** The bypassed-band run of a mode with a magnitude bound, see Bounds. */
+    static Result measureSplit(const Mode& mode, const Options& options);
+
+    static bool allPassed(const std::vector<Result>& results);
+    static juce::String formatReport(const std::vector<Result>& results);
+};
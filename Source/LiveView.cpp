@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    LiveView.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LiveView.h"
+
+LiveView::LiveView(int rate)
+    : refreshRateHz(rate) {}
+
+void LiveView::startRefreshing() {
+    refreshing = true;
+    updateShowing();
+}
+
+void LiveView::updateShowing() {
+    // Minimising the window comes through here too: the peer reports it as a visibility change.
+    const auto nowShowing = refreshing && isShowing();
+    if (nowShowing == showing)
+        return;
+
+    showing = nowShowing;
+
+    if (showing)
+        startTimerHz(refreshRateHz);
+    else
+        stopTimer();
+
+    showingChanged(showing);
+}
+
+void LiveView::timerCallback() {
+    refresh();
+}
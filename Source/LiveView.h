@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    LiveView.h
+    Created: 19 Oct 2026
+
+    Base of the editor's views that show live data (analyser, loudness,
+    meters, performance, profiler). Each refreshes at its own capped rate
+    and repaints only itself, and only when what it shows has changed.
+
+    While the view isn't on screen (editor hidden, window minimised, a tab
+    of the foleys layout not shown) its timer is stopped and it does nothing
+    at all; a watcher on the view and its parents starts it again when the
+    view comes back.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class LiveView : public juce::Component,
+                 private juce::Timer {
+protected:
+    explicit LiveView(int refreshRateHz);
+
+    /** Views with nothing to show (no processor) never call this. */
+    void startRefreshing();
+
+    /** At the refresh rate while showing: read the new data, repaint if it changed. */
+    virtual void refresh() = 0;
+
+    /** When the view appears on or leaves the screen, before the next refresh. */
+    virtual void showingChanged(bool isNowShowing) { juce::ignoreUnused(isNowShowing); }
+
+private:
+    // Told whenever the view or any of its parents is shown, hidden or moved to another window.
+    class ShowingWatcher : public juce::ComponentMovementWatcher {
+    public:
+        explicit ShowingWatcher(LiveView& v) : juce::ComponentMovementWatcher(&v), view(v) {}
+
+        void componentMovedOrResized(bool, bool) override {}
+        void componentPeerChanged() override { view.updateShowing(); }
+        void componentVisibilityChanged() override { view.updateShowing(); }
+
+    private:
+        LiveView& view;
+    };
+
+    void updateShowing();
+    void timerCallback() override;
+
+    const int refreshRateHz;
+    bool refreshing{ false };
+    bool showing{ false };
+
+    ShowingWatcher watcher{ *this };
+
+    JUCE_DECLARE_NON_COPYABLE(LiveView)
+};
@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+LoudnessMeter::LoudnessMeter()
+    : histogram((size_t)numBins) {
+
+    // Same design as the compressor's oversampled detector (DspKernels::makeDetectorInterpolator),
+    // longer: Kaiser-windowed sinc cut off at the original Nyquist, each phase at unity gain at DC.
+    constexpr auto length = upsampling * tapsPerPhase;
+    const auto pi = juce::MathConstants<double>::pi;
+
+    auto bessel = [](double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    };
+
+    const auto beta = 6.0;
+    double taps[length];
+
+    for (int i = 0; i < length; ++i) {
+        const auto t = (i - (length - 1) * 0.5) / upsampling;
+        const auto sinc = t == 0.0 ? 1.0 : std::sin(pi * t) / (pi * t);
+        const auto w = 2.0 * i / (length - 1) - 1.0;
+        taps[i] = sinc * bessel(beta * std::sqrt(1.0 - w * w)) / bessel(beta);
+    }
+
+    for (int phase = 0; phase < upsampling; ++phase) {
+        double sum = 0.0;
+        for (int k = 0; k < tapsPerPhase; ++k)
+            sum += taps[phase + k * upsampling];
+
+        for (int k = 0; k < tapsPerPhase; ++k)
+            interpolator[phase][k] = (float)(taps[phase + k * upsampling] / sum);
+    }
+}
+
+void LoudnessMeter::prepare(double sampleRate) {
+    // K-weighting at any rate: the two BS.1770 stages (given there for 48 kHz) as analogue
+    // prototypes through the bilinear transform, as libebur128 and pyloudnorm do.
+    const auto pi = juce::MathConstants<double>::pi;
+
+    {
+        const auto f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        const auto k = std::tan(pi * f0 / sampleRate);
+        const auto vh = std::pow(10.0, gainDb / 20.0);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const auto f0 = 38.13547087602444, q = 0.5003270373238773;
+        const auto k = std::tan(pi * f0 / sampleRate);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    subBlockLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    reset();
+}
+
+void LoudnessMeter::reset() noexcept {
+    std::memset(shelfState, 0, sizeof(shelfState));
+    std::memset(highPassState, 0, sizeof(highPassState));
+    std::memset(truePeakHistory, 0, sizeof(truePeakHistory));
+    truePeakPosition = 0;
+    maxTruePeak = 0;
+
+    subBlockSum = 0;
+    subBlockPosition = 0;
+    subBlocks.fill(0.0);
+    subBlockIndex = 0;
+    numSubBlocks = 0;
+    momentarySum = 0;
+    shortTermSum = 0;
+
+    std::fill(histogram.begin(), histogram.end(), Bin{});
+    numGated = 0;
+    gatedEnergy = 0;
+    highestBin = -1;
+
+    momentary.store(minLoudness, std::memory_order_relaxed);
+    shortTerm.store(minLoudness, std::memory_order_relaxed);
+    integrated.store(minLoudness, std::memory_order_relaxed);
+    truePeak.store(0, std::memory_order_relaxed);
+}
+
+float LoudnessMeter::toLoudness(double energy) noexcept {
+    return energy > 0.0 ? juce::jmax(minLoudness, (float)(-0.691 + 10.0 * std::log10(energy))) : minLoudness;
+}
+
+float LoudnessMeter::processTruePeak(float* history, int position, float sample) const noexcept {
+    history[position] = sample;
+    history[position + tapsPerPhase] = sample;
+
+    // history[position + k] is the sample k ago.
+    const auto* window = history + position;
+    auto peak = 0.0f;
+
+    for (int phase = 0; phase < upsampling; ++phase) {
+        auto sum = 0.0f;
+        for (int k = 0; k < tapsPerPhase; ++k)
+            sum += interpolator[phase][k] * window[k];
+        peak = juce::jmax(peak, std::abs(sum));
+    }
+
+    return peak;
+}
+
+void LoudnessMeter::process(const float* const* channels, int numChannels, int numSamples) noexcept {
+    if (resetRequested.load(std::memory_order_relaxed)) {
+        resetRequested.store(false, std::memory_order_relaxed);
+        reset();
+    }
+
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    // Runs up to the end of the current sub-block, one channel after the other.
+    for (int start = 0; start < numSamples;) {
+        const auto count = juce::jmin(numSamples - start, subBlockLength - subBlockPosition);
+        auto sum = 0.0;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto* samples = channels[ch] + start;
+            auto* history = truePeakHistory[ch];
+            auto position = truePeakPosition;
+
+            auto s0 = shelfState[ch][0], s1 = shelfState[ch][1];
+            auto h0 = highPassState[ch][0], h1 = highPassState[ch][1];
+
+            for (int i = 0; i < count; ++i) {
+                const double x = samples[i];
+
+                const auto y = shelf.b0 * x + s0;
+                s0 = shelf.b1 * x - shelf.a1 * y + s1;
+                s1 = shelf.b2 * x - shelf.a2 * y;
+
+                const auto z = highPass.b0 * y + h0;
+                h0 = highPass.b1 * y - highPass.a1 * z + h1;
+                h1 = highPass.b2 * y - highPass.a2 * z;
+
+                sum += z * z;
+
+                position = position == 0 ? tapsPerPhase - 1 : position - 1;
+                maxTruePeak = juce::jmax(maxTruePeak, processTruePeak(history, position, samples[i]));
+            }
+
+            shelfState[ch][0] = s0;
+            shelfState[ch][1] = s1;
+            highPassState[ch][0] = h0;
+            highPassState[ch][1] = h1;
+        }
+
+        truePeakPosition = (truePeakPosition + tapsPerPhase - count % tapsPerPhase) % tapsPerPhase;
+
+        subBlockSum += sum;
+        subBlockPosition += count;
+        start += count;
+
+        if (subBlockPosition == subBlockLength)
+            endSubBlock();
+    }
+
+    truePeak.store(maxTruePeak, std::memory_order_relaxed);
+}
+
+void LoudnessMeter::endSubBlock() noexcept {
+    // Mean square of each channel, summed (every channel weighs 1.0).
+    const auto energy = subBlockSum / subBlockLength;
+    subBlockSum = 0;
+    subBlockPosition = 0;
+
+    // subBlocks[subBlockIndex] is the sub-block that leaves the 3 s window, the one
+    // subBlocksPerMomentary before it the one that leaves the 400 ms window.
+    const auto leavingMomentary = subBlocks[(size_t)((subBlockIndex + subBlocksPerShortTerm - subBlocksPerMomentary) % subBlocksPerShortTerm)];
+    momentarySum += energy - leavingMomentary;
+    shortTermSum += energy - subBlocks[(size_t)subBlockIndex];
+
+    subBlocks[(size_t)subBlockIndex] = energy;
+    subBlockIndex = (subBlockIndex + 1) % subBlocksPerShortTerm;
+    ++numSubBlocks;
+
+    // Once per turn of the ring, sum again from scratch so rounding errors can't pile up.
+    if (subBlockIndex == 0) {
+        shortTermSum = 0;
+        for (auto e : subBlocks)
+            shortTermSum += e;
+
+        momentarySum = 0;
+        for (int i = 1; i <= subBlocksPerMomentary; ++i)
+            momentarySum += subBlocks[(size_t)(subBlocksPerShortTerm - i)];
+    }
+
+    // Before the windows are full they run over the silence before the start.
+    const auto momentaryEnergy = juce::jmax(0.0, momentarySum) / subBlocksPerMomentary;
+    momentary.store(toLoudness(momentaryEnergy), std::memory_order_relaxed);
+    shortTerm.store(toLoudness(juce::jmax(0.0, shortTermSum) / subBlocksPerShortTerm), std::memory_order_relaxed);
+
+    if (numSubBlocks >= subBlocksPerMomentary) {
+        addGatingBlock(momentaryEnergy);
+        integrated.store(computeIntegrated(), std::memory_order_relaxed);
+    }
+}
+
+void LoudnessMeter::addGatingBlock(double energy) noexcept {
+    const auto loudness = toLoudness(energy);
+    if (loudness <= absoluteGate)
+        return;
+
+    const auto bin = juce::jmin(numBins - 1, (int)((loudness - absoluteGate) * binsPerLu));
+    histogram[(size_t)bin].count += 1;
+    histogram[(size_t)bin].energy += energy;
+
+    numGated += 1;
+    gatedEnergy += energy;
+    highestBin = juce::jmax(highestBin, bin);
+}
+
+float LoudnessMeter::computeIntegrated() const noexcept {
+    if (numGated == 0)
+        return minLoudness;
+
+    // Blocks in the bins wholly above the relative gate.
+    const auto gate = toLoudness(gatedEnergy / (double)numGated) + relativeGate;
+    const auto firstBin = juce::jmax(0, (int)std::ceil((gate - absoluteGate) * binsPerLu));
+
+    juce::int64 count = 0;
+    double energy = 0;
+
+    for (int bin = firstBin; bin <= highestBin; ++bin) {
+        count += histogram[(size_t)bin].count;
+        energy += histogram[(size_t)bin].energy;
+    }
+
+    return count > 0 ? toLoudness(energy / (double)count) : minLoudness;
+}
+
+LoudnessMeter::Reading LoudnessMeter::getReading() const noexcept {
+    Reading reading;
+    reading.momentary = momentary.load(std::memory_order_relaxed);
+    reading.shortTerm = shortTerm.load(std::memory_order_relaxed);
+    reading.integrated = integrated.load(std::memory_order_relaxed);
+    reading.truePeak = juce::Decibels::gainToDecibels(truePeak.load(std::memory_order_relaxed), minLoudness);
+    return reading;
+}
+
+juce::String LoudnessMeter::toString(float loudness) {
+    return loudness <= minLoudness ? juce::String("-inf") : juce::String(loudness, 1);
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026
+
+    Loudness and true peak of one signal after ITU-R BS.1770-4 / EBU R 128:
+    momentary (400 ms), short-term (3 s) and gated integrated loudness in
+    LUFS, and the true peak in dBTP since the last reset.
+
+    Everything is incremental, with no history of the audio. The K-weighted
+    signal is summed into 100 ms sub-blocks; a ring of the last 30 keeps the
+    400 ms and 3 s windows as running sums, updated in O(1) per sub-block.
+    Every sub-block closes one 400 ms gating block (75 % overlap), which goes
+    into a histogram of block loudness with its energy, so the relative gate
+    and the integrated loudness come from the histogram instead of a list of
+    every block since the start. The result is exact except for blocks that
+    fall into the same 0.01 LU bin as the relative gate.
+
+    The true peak is the largest magnitude of the signal upsampled four
+    times (BS.1770 annex 2), with a 48 tap Kaiser-windowed sinc.
+
+    process() runs on the audio thread (or a renderer's thread); the
+    readings are atomics any thread can read while it runs.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class LoudnessMeter {
+public:
+    static constexpr int maxChannels = 2;           // weighted 1.0 each, as left and right
+    static constexpr float minLoudness = -100.0f;   // reported for silence and before the first block
+
+    struct Reading {
+        float momentary{ minLoudness };             // LUFS
+        float shortTerm{ minLoudness };
+        float integrated{ minLoudness };
+        float truePeak{ minLoudness };              // dBTP
+    };
+
+    LoudnessMeter();
+
+    /** Sets the filters up for the rate and starts over. Not while processing. */
+    void prepare(double sampleRate);
+
+    /** Starts the measurement over; from the thread that calls process. */
+    void reset() noexcept;
+
+    /** Any thread: the next process() call starts over. */
+    void requestReset() noexcept { resetRequested.store(true, std::memory_order_relaxed); }
+
+    /** Channels past maxChannels are ignored. */
+    void process(const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    Reading getReading() const noexcept;
+
+    /** -inf for minLoudness, one decimal otherwise. */
+    static juce::String toString(float loudness);
+
+private:
+    static constexpr int subBlocksPerMomentary = 4;     // 400 ms of 100 ms sub-blocks
+    static constexpr int subBlocksPerShortTerm = 30;    // 3 s
+    static constexpr float absoluteGate = -70.0f;       // LUFS
+    static constexpr float relativeGate = -10.0f;       // LU below the absolute-gated loudness
+
+    static constexpr float histogramTop = 10.0f;        // LUFS; louder blocks count in the top bin
+    static constexpr float binsPerLu = 100.0f;
+    static constexpr int numBins = (int)((histogramTop - absoluteGate) * binsPerLu);
+
+    static constexpr int upsampling = 4;
+    static constexpr int tapsPerPhase = 12;
+
+    struct Biquad {
+        double b0{ 1 }, b1{ 0 }, b2{ 0 }, a1{ 0 }, a2{ 0 };
+    };
+
+    struct Bin {
+        juce::int64 count{ 0 };
+        double energy{ 0 };
+    };
+
+    static float toLoudness(double energy) noexcept;
+
+    void endSubBlock() noexcept;
+    void addGatingBlock(double energy) noexcept;
+    float computeIntegrated() const noexcept;
+    float processTruePeak(float* history, int position, float sample) const noexcept;
+
+    std::atomic<float> momentary{ minLoudness };
+    std::atomic<float> shortTerm{ minLoudness };
+    std::atomic<float> integrated{ minLoudness };
+    std::atomic<float> truePeak{ 0 };               // linear
+    std::atomic<bool> resetRequested{ false };
+
+    // Set by prepare, the interpolator by the constructor.
+    Biquad shelf, highPass;
+    int subBlockLength{ 4410 };
+    float interpolator[upsampling][tapsPerPhase]{};
+
+    // Processing state, reset by reset().
+    double shelfState[maxChannels][2]{};
+    double highPassState[maxChannels][2]{};
+    float truePeakHistory[maxChannels][tapsPerPhase * 2]{};     // written twice, read contiguously
+    int truePeakPosition{ 0 };
+    float maxTruePeak{ 0 };
+
+    double subBlockSum{ 0 };
+    int subBlockPosition{ 0 };
+    std::array<double, subBlocksPerShortTerm> subBlocks{};      // mean square of each, summed over channels
+    int subBlockIndex{ 0 };
+    juce::int64 numSubBlocks{ 0 };
+    double momentarySum{ 0 };
+    double shortTermSum{ 0 };
+
+    std::vector<Bin> histogram;
+    juce::int64 numGated{ 0 };                      // blocks over the absolute gate
+    double gatedEnergy{ 0 };
+    int highestBin{ -1 };
+
+    JUCE_DECLARE_NON_COPYABLE(LoudnessMeter)
+};
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    LoudnessPanel.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LoudnessPanel.h"
+#include "PluginProcessor.h"
+
+namespace {
+    bool hasChanged(const LoudnessMeter::Reading& a, const LoudnessMeter::Reading& b) {
+        // To the tenth shown.
+        auto differs = [](float x, float y) { return std::abs(x - y) >= 0.05f; };
+        return differs(a.momentary, b.momentary) || differs(a.shortTerm, b.shortTerm)
+            || differs(a.integrated, b.integrated) || differs(a.truePeak, b.truePeak);
+    }
+}
+
+//==============================================================================
+LoudnessView::LoudnessView(Multiband_compAudioProcessor* processorToShow)
+    : LiveView(10), processor(processorToShow) {
+
+    // The momentary loudness moves every 100 ms.
+    if (processor != nullptr)
+        startRefreshing();
+}
+
+void LoudnessView::refresh() {
+    const auto newInput = processor->getInputLoudness();
+    const auto newOutput = processor->getOutputLoudness();
+
+    if (!hasChanged(newInput, input) && !hasChanged(newOutput, output))
+        return;
+
+    input = newInput;
+    output = newOutput;
+    repaint();
+}
+
+void LoudnessView::mouseDoubleClick(const juce::MouseEvent&) {
+    if (processor != nullptr)
+        processor->resetLoudness();
+}
+
+void LoudnessView::paint(juce::Graphics& g) {
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(4);
+
+    if (processor == nullptr)
+        return;
+
+    const auto rowHeight = area.getHeight() / 3;
+
+    auto drawColumns = [&g](juce::Rectangle<int> r, std::initializer_list<juce::String> texts) {
+        const auto width = r.getWidth() / (int)texts.size();
+        for (auto& text : texts)
+            g.drawText(text, r.removeFromLeft(width), juce::Justification::centredLeft);
+    };
+
+    g.setColour(juce::Colours::grey);
+    drawColumns(area.removeFromTop(rowHeight), { "", "momentary", "short-term", "integrated", "true peak" });
+
+    auto drawReading = [&](const juce::String& name, const LoudnessMeter::Reading& r) {
+        // Over 0 dBTP the file clips on conversion, worth noticing.
+        g.setColour(r.truePeak > 0.0f ? juce::Colours::orange : juce::Colours::white);
+        drawColumns(area.removeFromTop(rowHeight), { name,
+                                                     LoudnessMeter::toString(r.momentary) + " LUFS",
+                                                     LoudnessMeter::toString(r.shortTerm) + " LUFS",
+                                                     LoudnessMeter::toString(r.integrated) + " LUFS",
+                                                     LoudnessMeter::toString(r.truePeak) + " dBTP" });
+    };
+
+    drawReading("in", input);
+    drawReading("out", output);
+}
+
+//==============================================================================
+LoudnessPanel::LoudnessPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node)
+    : foleys::GuiItem(builder, node),
+      view(dynamic_cast<Multiband_compAudioProcessor*>(builder.getMagicState().getProcessor())) {
+
+    addAndMakeVisible(view);
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    LoudnessPanel.h
+    Created: 19 Oct 2026
+
+    Loudness readout of the editor: momentary, short-term and integrated
+    loudness and the true peak of the input and the output, from the
+    processor's LoudnessMeters. Registered with the foleys builder as
+    <Loudness/>; double-click it to start the measurement over.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LiveView.h"
+#include "LoudnessMeter.h"
+
+class Multiband_compAudioProcessor;
+
+class LoudnessView : public LiveView {
+public:
+    explicit LoudnessView(Multiband_compAudioProcessor* processorToShow);
+
+    void paint(juce::Graphics& g) override;
+    void mouseDoubleClick(const juce::MouseEvent&) override;
+
+private:
+    void refresh() override;
+
+    Multiband_compAudioProcessor* processor;
+
+    LoudnessMeter::Reading input, output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessView)
+};
+
+class LoudnessPanel : public foleys::GuiItem {
+public:
+    FOLEYS_DECLARE_GUI_FACTORY(LoudnessPanel)
+
+    LoudnessPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node);
+
+    void update() override {}
+    juce::Component* getWrappedComponent() override { return &view; }
+
+private:
+    LoudnessView view;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessPanel)
+};
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    MeterView.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "MeterView.h"
+
+namespace {
+    constexpr int refreshRateHz = 30;
+
+    constexpr float minLevel = -60.0f;
+    constexpr float maxReduction = -24.0f;
+    constexpr float fallDecibelsPerSecond = 24.0f;
+
+    constexpr float labelHeight = 14.0f;
+}
+
+//==============================================================================
+MeterView::MeterView(MeterDisplay* displayToShow)
+    : LiveView(refreshRateHz), display(displayToShow) {
+
+    for (int bar = 0; bar < numBars; ++bar)
+        shown[(size_t)bar] = bar >= reduction && bar < reductionEnd ? 0.0f : minLevel;
+
+    setOpaque(false);
+
+    if (display != nullptr)
+        startRefreshing();
+}
+
+void MeterView::refresh() {
+    display->update();
+    const auto peaks = display->takePeaks();
+
+    auto changed = false;
+
+    auto fall = [&](int bar, float peak) {
+        const auto level = juce::Decibels::gainToDecibels(peak, minLevel);
+        const auto next = juce::jmax(level, shown[(size_t)bar] - fallDecibelsPerSecond / refreshRateHz, minLevel);
+
+        changed = changed || std::abs(next - shown[(size_t)bar]) > 0.1f;
+        shown[(size_t)bar] = next;
+    };
+
+    fall(inputLeft, peaks.input[0]);
+    fall(inputRight, display->getNumChannels() > 1 ? peaks.input[1] : peaks.input[0]);
+    fall(outputLeft, peaks.output[0]);
+    fall(outputRight, display->getNumChannels() > 1 ? peaks.output[1] : peaks.output[0]);
+
+    for (int band = 0; band < Metering::numBands; ++band) {
+        fall(bandInput + band, peaks.bandInput[band]);
+        fall(bandOutput + band, peaks.bandOutput[band]);
+
+        const auto gainReduction = display->getGainReduction(band, MeterDisplay::historySize - 1);
+        changed = changed || std::abs(gainReduction - shown[(size_t)(reduction + band)]) > 0.1f;
+        shown[(size_t)(reduction + band)] = gainReduction;
+    }
+
+    if (changed)
+        repaint();
+}
+
+void MeterView::resized() {
+    background = {};
+}
+
+juce::Rectangle<float> MeterView::getBarArea(int bar) const {
+    auto area = getLocalBounds().toFloat().reduced(2.0f).withTrimmedBottom(labelHeight);
+    const auto width = area.getWidth() / (float)numBars;
+
+    return area.withX(area.getX() + width * (float)bar).withWidth(width).reduced(width * 0.2f, 0.0f);
+}
+
+void MeterView::renderBackground(float scale) {
+    backgroundScale = scale;
+    background = juce::Image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt((float)getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt((float)getHeight() * scale)), true);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    g.setFont(11.0f);
+
+    const char* bandNames[] = { "low", "mid", "high" };
+
+    for (int bar = 0; bar < numBars; ++bar) {
+        const auto area = getBarArea(bar);
+
+        g.setColour(juce::Colours::black.withAlpha(0.4f));
+        g.fillRect(area);
+
+        juce::String label;
+        if (bar == inputLeft || bar == outputLeft)
+            label = bar == inputLeft ? "in L" : "out L";
+        else if (bar == inputRight || bar == outputRight)
+            label = bar == inputRight ? "in R" : "out R";
+        else if (bar < bandInputEnd)
+            label = juce::String(bandNames[bar - bandInput]) + " in";
+        else if (bar < reductionEnd)
+            label = juce::String("GR ") + bandNames[bar - reduction];
+        else
+            label = juce::String(bandNames[bar - bandOutput]) + " out";
+
+        g.setColour(juce::Colours::grey);
+        g.drawFittedText(label, area.withY(area.getBottom()).withHeight(labelHeight).expanded(4.0f, 0.0f).toNearestInt(),
+                         juce::Justification::centred, 1);
+    }
+
+    // A tick every 12 dB across the level bars.
+    g.setColour(juce::Colours::white.withAlpha(0.15f));
+    const auto scaleArea = getBarArea(0);
+    for (auto decibels = -12.0f; decibels > minLevel; decibels -= 12.0f) {
+        const auto y = juce::jmap(decibels, 0.0f, minLevel, scaleArea.getY(), scaleArea.getBottom());
+        g.drawHorizontalLine(juce::roundToInt(y), 0.0f, (float)getWidth());
+    }
+}
+
+void MeterView::paint(juce::Graphics& g) {
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (background.isNull() || scale != backgroundScale)
+        renderBackground(scale);
+
+    g.drawImage(background, getLocalBounds().toFloat());
+
+    for (int bar = 0; bar < numBars; ++bar) {
+        const auto area = getBarArea(bar);
+        const auto value = shown[(size_t)bar];
+
+        if (bar >= reduction && bar < reductionEnd) {
+            // Gain reduction hangs from the top.
+            const auto height = area.getHeight() * juce::jlimit(0.0f, 1.0f, value / maxReduction);
+            g.setColour(juce::Colours::orange);
+            g.fillRect(area.withHeight(height));
+            continue;
+        }
+
+        const auto height = area.getHeight() * juce::jmap(value, minLevel, 0.0f, 0.0f, 1.0f);
+        g.setColour(value > -0.1f ? juce::Colours::red : juce::Colour(0xFF8EB12E));
+        g.fillRect(area.withTrimmedTop(area.getHeight() - height));
+    }
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    MeterView.h
+    Created: 19 Oct 2026
+
+    Meter strip of the native editor: peak bars of the input, of each band
+    before and after its compressor and of the output, and the gain
+    reduction of each band, from the processor's MeterDisplay. The scale
+    and the labels are drawn once into a cached image; a refresh only
+    repaints the bars, and only when one has moved.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LiveView.h"
+#include "Metering.h"
+
+class MeterView : public LiveView {
+public:
+    explicit MeterView(MeterDisplay* displayToShow);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    // Columns, left to right.
+    enum Bar {
+        inputLeft, inputRight,
+        bandInput, bandInputEnd = bandInput + Metering::numBands,
+        reduction = bandInputEnd, reductionEnd = reduction + Metering::numBands,
+        bandOutput = reductionEnd, bandOutputEnd = bandOutput + Metering::numBands,
+        outputLeft = bandOutputEnd, outputRight,
+
+        numBars
+    };
+
+    void refresh() override;
+
+    juce::Rectangle<float> getBarArea(int bar) const;
+    void renderBackground(float scale);
+
+    MeterDisplay* display;
+
+    // dB; levels fall at a meter's rate, gain reduction follows the frames.
+    std::array<float, numBars> shown;
+
+    juce::Image background;
+    float backgroundScale{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterView)
+};
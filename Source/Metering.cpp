@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    Metering.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "Metering.h"
+
+Metering::Frame Metering::Frame::empty() noexcept {
+    Frame frame{};
+    std::fill(std::begin(frame.bandGain), std::end(frame.bandGain), 1.0f);
+    return frame;
+}
+
+Metering::Metering()
+    : frames((size_t)capacity) {}
+
+void Metering::prepare(double sampleRate, int newNumChannels) noexcept {
+    numChannels = juce::jmin(newNumChannels, maxChannels);
+    samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate * frameSeconds));
+    samplesInFrame = 0;
+    current = Frame::empty();
+}
+
+float Metering::getPeak(const float* channel, int numSamples) noexcept {
+    const auto range = juce::FloatVectorOperations::findMinAndMax(channel, numSamples);
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+float Metering::getPeak(const float* const* channels, int numChannelsToScan, int numSamples) noexcept {
+    auto peak = 0.0f;
+    for (int ch = 0; ch < numChannelsToScan; ++ch)
+        peak = juce::jmax(peak, getPeak(channels[ch], numSamples));
+    return peak;
+}
+
+void Metering::addInput(const float* const* channels, int numChannelsToScan, int numSamples) noexcept {
+    for (int ch = 0; ch < juce::jmin(numChannelsToScan, maxChannels); ++ch)
+        current.input[ch] = juce::jmax(current.input[ch], getPeak(channels[ch], numSamples));
+}
+
+void Metering::addBandInput(int band, const float* const* channels, int numChannelsToScan, int numSamples) noexcept {
+    current.bandInput[band] = juce::jmax(current.bandInput[band], getPeak(channels, numChannelsToScan, numSamples));
+}
+
+void Metering::addBandOutput(int band, const float* const* channels, int numChannelsToScan, int numSamples) noexcept {
+    current.bandOutput[band] = juce::jmax(current.bandOutput[band], getPeak(channels, numChannelsToScan, numSamples));
+}
+
+void Metering::addBandGain(int band, float minGain) noexcept {
+    current.bandGain[band] = juce::jmin(current.bandGain[band], minGain);
+}
+
+void Metering::addOutput(const float* const* channels, int numChannelsToScan, int numSamples) noexcept {
+    for (int ch = 0; ch < juce::jmin(numChannelsToScan, maxChannels); ++ch)
+        current.output[ch] = juce::jmax(current.output[ch], getPeak(channels[ch], numSamples));
+}
+
+bool Metering::endBlock(int numSamples) noexcept {
+    samplesInFrame += numSamples;
+    if (samplesInFrame < samplesPerFrame)
+        return false;
+
+    samplesInFrame = 0;
+
+    const juce::AbstractFifo::ScopedWrite write(fifo, 1);
+    const auto pushed = write.blockSize1 > 0;
+
+    if (pushed)
+        frames[(size_t)write.startIndex1] = current;
+    else
+        numDropped.store(numDropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    current = Frame::empty();
+    return pushed;
+}
+
+bool Metering::pop(Frame& frame) noexcept {
+    const juce::AbstractFifo::ScopedRead read(fifo, 1);
+    if (read.blockSize1 == 0)
+        return false;
+
+    frame = frames[(size_t)read.startIndex1];
+    return true;
+}
+
+//==============================================================================
+class MeterDisplay::GainReductionPlot : public foleys::MagicPlotSource {
+public:
+    GainReductionPlot(MeterDisplay& d, int b) : display(d), band(b) {}
+
+    void pushSamples(const juce::AudioBuffer<float>&) override {}
+
+    void newFrame() noexcept { resetLastDataUpdate(); }
+
+    void createPlotPaths(juce::Path& path, juce::Path& filledPath, juce::Rectangle<float> bounds,
+                         foleys::MagicPlotComponent&) override {
+        display.update();
+
+        // 0 dB at the top, maxReductionDb at the bottom, newest frame on the right.
+        constexpr auto maxReductionDb = 24.0f;
+        auto toY = [&](float gainReduction) {
+            return juce::jmap(juce::jlimit(-maxReductionDb, 0.0f, gainReduction), 0.0f, -maxReductionDb,
+                              bounds.getY(), bounds.getBottom());
+        };
+
+        path.clear();
+        filledPath.clear();
+
+        for (int i = 0; i < historySize; ++i) {
+            const auto x = juce::jmap((float)i, 0.0f, (float)(historySize - 1), bounds.getX(), bounds.getRight());
+            const auto y = toY(display.getGainReduction(band, i));
+
+            if (i == 0)
+                path.startNewSubPath(x, y);
+            else
+                path.lineTo(x, y);
+        }
+
+        filledPath = path;
+        filledPath.lineTo(bounds.getTopRight());
+        filledPath.lineTo(bounds.getTopLeft());
+        filledPath.closeSubPath();
+    }
+
+private:
+    MeterDisplay& display;
+    const int band;
+};
+
+//==============================================================================
+MeterDisplay::MeterDisplay(Metering& m, foleys::MagicProcessorState& magicState)
+    : metering(m) {
+
+    inputLevel = magicState.createAndAddObject<foleys::MagicLevelSource>("input");
+    outputLevel = magicState.createAndAddObject<foleys::MagicLevelSource>("output");
+    bandInputLevel = magicState.createAndAddObject<foleys::MagicLevelSource>("band-input");
+    bandOutputLevel = magicState.createAndAddObject<foleys::MagicLevelSource>("band-output");
+
+    const char* plotNames[] = { "gr-low", "gr-mid", "gr-high" };
+    for (int band = 0; band < Metering::numBands; ++band)
+        plots[(size_t)band] = magicState.createAndAddObject<GainReductionPlot>(plotNames[band], *this, band);
+
+    prepare(Metering::maxChannels);
+}
+
+void MeterDisplay::prepare(int numChannels) {
+    // The sources see one value per frame, so their "sample rate" is the frame rate.
+    const auto frameRate = 1.0 / Metering::frameSeconds;
+
+    inputLevel->setupSource(numChannels, frameRate, 500, 200);
+    outputLevel->setupSource(numChannels, frameRate, 500, 200);
+    bandInputLevel->setupSource(Metering::numBands, frameRate, 500, 200);
+    bandOutputLevel->setupSource(Metering::numBands, frameRate, 500, 200);
+}
+
+void MeterDisplay::update() {
+    Metering::Frame frame;
+
+    while (metering.pop(frame)) {
+        for (int ch = 0; ch < Metering::maxChannels; ++ch) {
+            peaks.input[ch] = juce::jmax(peaks.input[ch], frame.input[ch]);
+            peaks.output[ch] = juce::jmax(peaks.output[ch], frame.output[ch]);
+        }
+        for (int band = 0; band < Metering::numBands; ++band) {
+            peaks.bandInput[band] = juce::jmax(peaks.bandInput[band], frame.bandInput[band]);
+            peaks.bandOutput[band] = juce::jmax(peaks.bandOutput[band], frame.bandOutput[band]);
+            peaks.bandGain[band] = juce::jmin(peaks.bandGain[band], frame.bandGain[band]);
+        }
+
+        const auto numChannels = juce::jmax(1, metering.getNumChannels());
+        juce::AudioBuffer<float> channels(channelValues.getArrayOfWritePointers(), numChannels, 1);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels.setSample(ch, 0, frame.input[ch]);
+        inputLevel->pushSamples(channels);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels.setSample(ch, 0, frame.output[ch]);
+        outputLevel->pushSamples(channels);
+
+        for (int band = 0; band < Metering::numBands; ++band)
+            bandValues.setSample(band, 0, frame.bandInput[band]);
+        bandInputLevel->pushSamples(bandValues);
+
+        for (int band = 0; band < Metering::numBands; ++band) {
+            bandValues.setSample(band, 0, frame.bandOutput[band]);
+            history[(size_t)band][(size_t)historyWrite] = juce::jmin(0.0f, juce::Decibels::gainToDecibels(frame.bandGain[band]));
+        }
+        bandOutputLevel->pushSamples(bandValues);
+
+        historyWrite = (historyWrite + 1) % historySize;
+    }
+}
+
+Metering::Frame MeterDisplay::takePeaks() noexcept {
+    const auto taken = peaks;
+    peaks = Metering::Frame::empty();
+    return taken;
+}
+
+float MeterDisplay::getGainReduction(int band, int index) const noexcept {
+    return history[(size_t)band][(size_t)((historyWrite + index) % historySize)];
+}
+
+void MeterDisplay::notifyNewFrame() noexcept {
+    for (auto* plot : plots)
+        plot->newFrame();
+}
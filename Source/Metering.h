@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    Metering.h
+    Created: 19 Oct 2026
+
+    Level and gain reduction meters for the editor.
+
+    The audio thread keeps running peaks of the input, of each band before
+    and after its compressor, and of the output, plus the lowest gain each
+    band's compressor applied (DspEngine::getMinGain). Every frameSeconds (at a
+    block boundary) it pushes one Frame into a wait-free SPSC FIFO and
+    starts over. Nothing is locked or allocated; if nobody reads, frames
+    are dropped and counted.
+
+    The message thread drains the FIFO from MeterDisplay::update(), which
+    the gain reduction plots call whenever they redraw, and hands the
+    frames on to the foleys sources:
+
+        level sources "input", "output"        one channel per audio channel
+        level sources "band-input", "band-output"   low, mid, high
+        plot sources "gr-low", "gr-mid", "gr-high"  gain reduction history
+
+    The level sources get one value per frame (its peak), so their RMS is
+    the RMS of the peak envelope, not of the audio.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "DspStateArena.h"
+
+class Metering {
+public:
+    static constexpr int numBands = DspStateArena::numBands;
+    static constexpr int maxChannels = 2;           // the plugin's buses are mono or stereo
+    static constexpr double frameSeconds = 1.0 / 60.0;
+
+    struct Frame {
+        float input[maxChannels];
+        float output[maxChannels];
+        float bandInput[numBands];                  // peak over all channels
+        float bandOutput[numBands];
+        float bandGain[numBands];                   // lowest compressor gain, 1 for none
+
+        /** Nothing measured yet: silent levels, unity gains. */
+        static Frame empty() noexcept;
+    };
+
+    Metering();
+
+    /** Not while processing. The FIFO itself is allocated once, in the constructor. */
+    void prepare(double sampleRate, int numChannels) noexcept;
+    int getNumChannels() const noexcept { return numChannels; }
+
+    //==============================================================================
+    // Audio thread. Stages that don't run in a block (a bypassed band) leave their peak alone.
+
+    void addInput(const float* const* channels, int numChannels, int numSamples) noexcept;
+    void addBandInput(int band, const float* const* channels, int numChannels, int numSamples) noexcept;
+    void addBandOutput(int band, const float* const* channels, int numChannels, int numSamples) noexcept;
+    void addBandGain(int band, float minGain) noexcept;
+    void addOutput(const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    /** Call at the end of each block. Returns true if a frame was pushed. */
+    bool endBlock(int numSamples) noexcept;
+
+    //==============================================================================
+    // Message thread.
+
+    bool pop(Frame& frame) noexcept;
+    juce::int64 getNumDropped() const noexcept { return numDropped.load(std::memory_order_relaxed); }
+
+private:
+    static float getPeak(const float* channel, int numSamples) noexcept;
+    static float getPeak(const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    static constexpr int capacity = 256;            // a few seconds of frames
+
+    juce::AbstractFifo fifo{ capacity };
+    std::vector<Frame> frames;
+    std::atomic<juce::int64> numDropped{ 0 };
+
+    // Audio thread only.
+    Frame current{ Frame::empty() };
+    int samplesPerFrame{ 735 };
+    int samplesInFrame{ 0 };
+    int numChannels{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(Metering)
+};
+
+//==============================================================================
+/** Message-thread side: drains the frames into the foleys sources. */
+class MeterDisplay {
+public:
+    static constexpr int historySize = 300;         // five seconds of frames
+
+    /** Creates the sources in magicState; call from the processor's constructor. */
+    explicit MeterDisplay(Metering& metering, foleys::MagicProcessorState& magicState);
+
+    /** Sets the level sources up for the channel count; from prepareToPlay. */
+    void prepare(int numChannels);
+
+    /** Drains whatever the audio thread pushed. Cheap when there is nothing new. */
+    void update();
+
+    /** Gain reduction of a band in dB (<= 0); index 0 is the oldest frame. */
+    float getGainReduction(int band, int index) const noexcept;
+
+    /** The loudest of the frames drained since the last call (and the deepest gain reduction),
+        for views that draw at their own rate (MeterView).
+    */
+    Metering::Frame takePeaks() noexcept;
+
+    int getNumChannels() const noexcept { return metering.getNumChannels(); }
+
+    /** Audio thread, when Metering::endBlock pushed a frame: tells the plots to redraw. */
+    void notifyNewFrame() noexcept;
+
+private:
+    Metering& metering;
+
+    foleys::MagicLevelSource* inputLevel{ nullptr };
+    foleys::MagicLevelSource* outputLevel{ nullptr };
+    foleys::MagicLevelSource* bandInputLevel{ nullptr };
+    foleys::MagicLevelSource* bandOutputLevel{ nullptr };
+
+    class GainReductionPlot;
+    std::array<GainReductionPlot*, Metering::numBands> plots{};
+
+    // One sample per frame for the level sources.
+    juce::AudioBuffer<float> channelValues{ Metering::maxChannels, 1 };
+    juce::AudioBuffer<float> bandValues{ Metering::numBands, 1 };
+
+    std::array<std::array<float, historySize>, Metering::numBands> history{};
+    int historyWrite{ 0 };
+
+    Metering::Frame peaks{ Metering::Frame::empty() };
+
+    JUCE_DECLARE_NON_COPYABLE(MeterDisplay)
+};
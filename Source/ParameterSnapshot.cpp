@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+#include "PluginProcessor.h"
+
+static_assert(ParameterSnapshot::numParameters == Params::Gain_Out + 1, "a parameter was added to Params::Names");
+
+namespace {
+    const char stateMagic[4] = { 'M', 'B', 'C', 'S' };
+}
+
+ParameterSnapshot::Parameters ParameterSnapshot::getParameters(juce::AudioProcessorValueTreeState& apvts) {
+    Parameters parameters{};
+
+    for (auto& p : Params::GetParams()) {
+        parameters[(size_t)p.first] = apvts.getParameter(p.second);
+        jassert(parameters[(size_t)p.first] != nullptr);
+    }
+
+    return parameters;
+}
+
+void ParameterSnapshot::capture(const Parameters& parameters) noexcept {
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = parameters[i]->convertFrom0to1(parameters[i]->getValue());
+}
+
+void ParameterSnapshot::captureDefaults(const Parameters& parameters) noexcept {
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = parameters[i]->convertFrom0to1(parameters[i]->getDefaultValue());
+}
+
+int ParameterSnapshot::applyTo(const Parameters& parameters) const noexcept {
+    int numChanged = 0;
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto* parameter = parameters[i];
+        const auto normalised = parameter->convertTo0to1(values[i]);
+
+        if (normalised == parameter->getValue())
+            continue;
+
+        parameter->setValueNotifyingHost(normalised);
+        ++numChanged;
+    }
+
+    return numChanged;
+}
+
+//==============================================================================
+void ParameterSnapshot::writeState(juce::MemoryBlock& destination, juce::uint32 flags) const {
+    const auto offset = destination.getSize();
+    destination.setSize(offset + stateSize);
+    auto* data = static_cast<char*>(destination.getData()) + offset;
+
+    auto write32 = [&data](juce::uint32 value) {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(data, &value, sizeof(value));
+        data += sizeof(value);
+    };
+
+    std::memcpy(data, stateMagic, sizeof(stateMagic));
+    data += sizeof(stateMagic);
+
+    write32((juce::uint32)formatVersion | ((juce::uint32)numParameters << 16));
+    write32(flags);
+
+    for (auto value : values) {
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write32(bits);
+    }
+}
+
+bool ParameterSnapshot::isState(const void* data, size_t size) noexcept {
+    return size >= headerSize && std::memcmp(data, stateMagic, sizeof(stateMagic)) == 0;
+}
+
+bool ParameterSnapshot::readState(const void* data, size_t size, juce::uint32& flags) noexcept {
+    if (!isState(data, size))
+        return false;
+
+    const auto* bytes = static_cast<const char*>(data);
+
+    // Newer versions have appended values, older ones have fewer: either way the count says how many are there.
+    const auto numStored = (size_t)juce::ByteOrder::littleEndianShort(bytes + 6);
+    if (size < headerSize + sizeof(float) * numStored)
+        return false;
+
+    flags = juce::ByteOrder::littleEndianInt(bytes + 8);
+
+    const auto* stored = bytes + headerSize;
+    for (size_t i = 0; i < juce::jmin(numStored, values.size()); ++i) {
+        const auto bits = juce::ByteOrder::littleEndianInt(stored + i * sizeof(float));
+        std::memcpy(&values[i], &bits, sizeof(float));
+    }
+
+    return true;
+}
+
+void ParameterSnapshot::readTree(const juce::ValueTree& state, const Parameters& parameters) {
+    static const juce::Identifier idProperty("id"), valueProperty("value");
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto child = state.getChildWithProperty(idProperty, parameters[i]->paramID);
+        if (child.hasProperty(valueProperty))
+            values[i] = child[valueProperty];
+    }
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 19 Oct 2026
+
+    Every parameter's value in one flat array, indexed by Params::Names and
+    in the units the APVTS stores them (dB, ms, Hz, the choice index for the
+    ratios, 0/1 for the switches). A snapshot is a plain value: copying,
+    comparing and storing one costs a hundred bytes and no allocation, which
+    is what the state blob, the preset bank and A/B comparison are built on.
+
+    applyTo() only sets the parameters whose value differs, each once, so
+    recalling a state sends as many notifications as there are changes
+    instead of rebuilding the APVTS tree like replaceState does.
+
+    The state blob (Multiband_compAudioProcessor::getStateInformation) is
+    little-endian: 'MBCS', a uint16 format version, a uint16 value count,
+    uint32 flags for the settings that aren't parameters, then the values as
+    floats in Names order. Versions only ever append values, so any version
+    reads: values a blob doesn't have keep what the snapshot had, values it
+    has past numParameters are ignored.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class ParameterSnapshot {
+public:
+    static constexpr int numParameters = 25;    // Params::Names, checked in the .cpp
+
+    /** The parameters in Names order. */
+    using Parameters = std::array<juce::RangedAudioParameter*, numParameters>;
+    static Parameters getParameters(juce::AudioProcessorValueTreeState& apvts);
+
+    float get(int parameter) const noexcept { return values[(size_t)parameter]; }
+    void set(int parameter, float value) noexcept { values[(size_t)parameter] = value; }
+
+    /** Reads the current values. */
+    void capture(const Parameters& parameters) noexcept;
+
+    /** The values the parameters were created with. */
+    void captureDefaults(const Parameters& parameters) noexcept;
+
+    /** Sets the parameters that differ, notifying the host; returns how many it set. */
+    int applyTo(const Parameters& parameters) const noexcept;
+
+    bool operator==(const ParameterSnapshot& other) const noexcept { return values == other.values; }
+    bool operator!=(const ParameterSnapshot& other) const noexcept { return values != other.values; }
+
+    //==============================================================================
+    static constexpr juce::uint16 formatVersion = 1;
+    static constexpr size_t headerSize = 12;
+    static constexpr size_t stateSize = headerSize + sizeof(float) * numParameters;
+
+    /** Appends the state blob to destination. */
+    void writeState(juce::MemoryBlock& destination, juce::uint32 flags) const;
+
+    /** False, with the snapshot untouched, if data isn't a state blob. */
+    bool readState(const void* data, size_t size, juce::uint32& flags) noexcept;
+
+    static bool isState(const void* data, size_t size) noexcept;
+
+    /** The ValueTree the APVTS saved before the blob existed; parameters it doesn't have keep their value. */
+    void readTree(const juce::ValueTree& state, const Parameters& parameters);
+
+private:
+    std::array<float, numParameters> values{};
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    PerformancePanel.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PerformancePanel.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+PerformanceView::PerformanceView(Multiband_compAudioProcessor* processorToShow)
+    : LiveView(5), processor(processorToShow) {
+
+    if (processor == nullptr)
+        return;
+
+    adaptiveButton.setToggleState(processor->isAdaptiveQuality(), juce::dontSendNotification);
+    adaptiveButton.onClick = [this] { processor->setAdaptiveQuality(adaptiveButton.getToggleState()); };
+    addAndMakeVisible(adaptiveButton);
+
+    pipelinedButton.setToggleState(processor->isPipelined(), juce::dontSendNotification);
+    pipelinedButton.onClick = [this] { processor->setPipelined(pipelinedButton.getToggleState()); };
+    addAndMakeVisible(pipelinedButton);
+
+    startRefreshing();
+}
+
+void PerformanceView::refresh() {
+    const auto& governor = processor->getQualityGovernor();
+
+    const auto newTier = governor.getTier();
+    const auto newLoad = governor.getLoad();
+    const auto newTierChanges = governor.getNumTierChanges();
+    const auto newUnderruns = processor->getNumPipelineUnderruns();
+
+    // The state may have been replaced by the host.
+    adaptiveButton.setToggleState(processor->isAdaptiveQuality(), juce::dontSendNotification);
+    pipelinedButton.setToggleState(processor->isPipelined(), juce::dontSendNotification);
+
+    // Only the text changes, and only now and then.
+    if (newTier == tier && std::abs(newLoad - load) < 0.005f && newTierChanges == numTierChanges && newUnderruns == numUnderruns)
+        return;
+
+    tier = newTier;
+    load = newLoad;
+    numTierChanges = newTierChanges;
+    numUnderruns = newUnderruns;
+    repaint();
+}
+
+void PerformanceView::resized() {
+    auto area = getLocalBounds().reduced(4);
+    auto buttons = area.removeFromRight(juce::jmin(area.getWidth() / 2, 420));
+
+    adaptiveButton.setBounds(buttons.removeFromLeft(buttons.getWidth() / 2));
+    pipelinedButton.setBounds(buttons);
+}
+
+void PerformanceView::paint(juce::Graphics& g) {
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(4);
+    area.removeFromRight(juce::jmin(area.getWidth() / 2, 420));
+
+    if (processor == nullptr)
+        return;
+
+    // Anything below full quality is worth noticing.
+    g.setColour(tier != QualityGovernor::full ? juce::Colours::orange : juce::Colours::white);
+    g.drawText(juce::String("quality: ") + QualityGovernor::getTierName(tier)
+                   + "   load " + juce::String(load * 100.0f, 1) + "%"
+                   + "   " + juce::String(numTierChanges) + " changes",
+               area.removeFromTop(area.getHeight() / 2), juce::Justification::centredLeft);
+
+    g.setColour(juce::Colours::white);
+    g.drawText(processor->isPipelineRunning()
+                   ? "pipelined, " + juce::String(processor->getLatencySamples()) + " samples latency, "
+                         + juce::String(numUnderruns) + " underruns"
+                   : juce::String("not pipelined"),
+               area, juce::Justification::centredLeft);
+}
+
+//==============================================================================
+PerformancePanel::PerformancePanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node)
+    : foleys::GuiItem(builder, node),
+      view(dynamic_cast<Multiband_compAudioProcessor*>(builder.getMagicState().getProcessor())) {
+
+    addAndMakeVisible(view);
+}
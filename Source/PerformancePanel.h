@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    PerformancePanel.h
+    Created: 19 Oct 2026
+
+    Performance strip of the editor: the quality tier the QualityGovernor
+    currently runs at, the smoothed load, and the pipelined mode, with
+    switches for both. Registered with the foleys builder as <Performance/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LiveView.h"
+
+class Multiband_compAudioProcessor;
+
+class PerformanceView : public LiveView {
+public:
+    explicit PerformanceView(Multiband_compAudioProcessor* processorToShow);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void refresh() override;
+
+    Multiband_compAudioProcessor* processor;
+
+    juce::ToggleButton adaptiveButton{ "adaptive quality" };
+    juce::ToggleButton pipelinedButton{ "pipelined (from next restart)" };
+
+    int tier{ 0 };
+    float load{ 0 };
+    juce::int64 numTierChanges{ 0 };
+    juce::int64 numUnderruns{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceView)
+};
+
+class PerformancePanel : public foleys::GuiItem {
+public:
+    FOLEYS_DECLARE_GUI_FACTORY(PerformancePanel)
+
+    PerformancePanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node);
+
+    void update() override {}
+    juce::Component* getWrappedComponent() override { return &view; }
+
+private:
+    PerformanceView view;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformancePanel)
+};
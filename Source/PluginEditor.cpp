@@ -9,32 +9,258 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    constexpr int editorWidth = 960;
+    constexpr int margin = 6;
+    constexpr int captionHeight = 16;
+    constexpr int knobCaptionHeight = 14;
+
+    const juce::Colour backgroundColour(0xFF1E2328);
+    const juce::Colour sectionColour(0xFF262C33);
+    const juce::Colour borderColour(0xFF3A424B);
+}
+
 //==============================================================================
 Multiband_compAudioProcessorEditor::Multiband_compAudioProcessorEditor(Multiband_compAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p)
+    : AudioProcessorEditor(&p), audioProcessor(p),
+      analyser(&p), meters(&p.getMeterDisplay()), loudness(&p), performance(&p), profiler(&p.getProfiler())
 {
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize(400, 300);
+    using namespace Params;
+
+    // Presets and A/B only ever set the parameters that differ, the attachments follow.
+    const auto& presets = audioProcessor.getPresets();
+    for (int i = 0; i < presets.size(); ++i)
+        presetBox.addItem(presets.getName(i), i + 1);
+    presetBox.setSelectedItemIndex(audioProcessor.getCurrentProgram(), juce::dontSendNotification);
+    presetBox.onChange = [this] { audioProcessor.setCurrentProgram(presetBox.getSelectedItemIndex()); };
+    addAndMakeVisible(presetBox);
+
+    for (auto* button : { &slotA, &slotB }) {
+        button->setClickingTogglesState(true);
+        button->setRadioGroupId(1);
+        addAndMakeVisible(*button);
+    }
+    slotA.onClick = [this] { if (slotA.getToggleState()) selectComparisonSlot(0); };
+    slotB.onClick = [this] { if (slotB.getToggleState()) selectComparisonSlot(1); };
+    copySlot.onClick = [this] { audioProcessor.copyToOtherComparisonSlot(); };
+    addAndMakeVisible(copySlot);
+    selectComparisonSlot(audioProcessor.getComparisonSlot());
+
+    addKnob(inputGain, Gain_In, "Input", " dB");
+    addKnob(lowMidCrossover, Low_Mid_Crossover_Freq, "Low / Mid", " Hz");
+    addKnob(midHighCrossover, Mid_High_Crossover_Freq, "Mid / High", " Hz");
+    addKnob(outputGain, Gain_Out, "Output", " dB");
+
+    for (int band = 0; band < DspStateArena::numBands; ++band) {
+        auto& controls = bands[(size_t)band];
+
+        // The per-band parameters are consecutive in Params::Names, low band first.
+        addKnob(controls.threshold, (Names)(Threshold_Low_Band + band), "Threshold", " dB");
+        addKnob(controls.attack, (Names)(Attack_Low_Band + band), "Attack", " ms");
+        addKnob(controls.release, (Names)(Release_Low_Band + band), "Release", " ms");
+
+        const auto& ratioName = GetParams().at((Names)(Ratio_Low_Band + band));
+        if (auto* ratio = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter(ratioName)))
+            controls.ratio.addItemList(ratio->choices, 1);
+        controls.ratioAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.apvts, ratioName, controls.ratio);
+        addAndMakeVisible(controls.ratio);
+
+        addToggle(controls.bypass, controls.bypassAttachment, (Names)(Bypassed_Low_Band + band));
+        addToggle(controls.mute, controls.muteAttachment, (Names)(Mute_Low_Band + band));
+        addToggle(controls.solo, controls.soloAttachment, (Names)(Solo_Low_Band + band));
+    }
+
+    addAndMakeVisible(analyser);
+    addAndMakeVisible(meters);
+    addAndMakeVisible(loudness);
+    addAndMakeVisible(performance);
+
+    // Only profiling builds have anything to show there.
+    if (StageProfiler::isEnabled())
+        addAndMakeVisible(profiler);
+
+    setOpaque(true);
+    setSize(editorWidth, StageProfiler::isEnabled() ? 1100 : 860);
 }
 
 Multiband_compAudioProcessorEditor::~Multiband_compAudioProcessorEditor()
 {
 }
 
+void Multiband_compAudioProcessorEditor::selectComparisonSlot(int slot)
+{
+    audioProcessor.setComparisonSlot(slot);
+
+    (slot == 0 ? slotA : slotB).setToggleState(true, juce::dontSendNotification);
+    copySlot.setButtonText(slot == 0 ? "A > B" : "B > A");
+}
+
+void Multiband_compAudioProcessorEditor::addKnob(Knob& knob, Params::Names parameter, const juce::String& caption,
+                                                  const juce::String& suffix)
+{
+    knob.caption = caption;
+    knob.slider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+    knob.slider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 80, 18);
+    knob.slider.setTextValueSuffix(suffix);
+    knob.attachment = std::make_unique<SliderAttachment>(audioProcessor.apvts, Params::GetParams().at(parameter), knob.slider);
+    addAndMakeVisible(knob.slider);
+}
+
+void Multiband_compAudioProcessorEditor::addToggle(juce::TextButton& button, std::unique_ptr<ButtonAttachment>& attachment,
+                                                    Params::Names parameter)
+{
+    button.setClickingTogglesState(true);
+    attachment = std::make_unique<ButtonAttachment>(audioProcessor.apvts, Params::GetParams().at(parameter), button);
+    addAndMakeVisible(button);
+}
+
 //==============================================================================
 void Multiband_compAudioProcessorEditor::paint(juce::Graphics& g)
 {
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+    // Only the clip region is blitted; the image is redrawn when the size or the display's scale changes.
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (background.isNull() || scale != backgroundScale)
+        renderBackground(scale);
 
-    g.setColour(juce::Colours::white);
-    g.setFont(15.0f);
-    g.drawFittedText("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
+    g.drawImage(background, getLocalBounds().toFloat());
+}
+
+void Multiband_compAudioProcessorEditor::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    background = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt((float)getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt((float)getHeight() * scale)), false);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    drawBackground(g);
+}
+
+void Multiband_compAudioProcessorEditor::drawBackground(juce::Graphics& g) const
+{
+    g.fillAll(backgroundColour);
+
+    for (auto& section : sections) {
+        const auto bounds = section.bounds.toFloat();
+
+        g.setColour(sectionColour);
+        g.fillRoundedRectangle(bounds, 4.0f);
+        g.setColour(borderColour);
+        g.drawRoundedRectangle(bounds.reduced(0.5f), 4.0f, 1.0f);
+
+        g.setColour(juce::Colours::lightgrey);
+        g.setFont(juce::Font(12.0f, juce::Font::bold));
+        g.drawText(section.caption, section.bounds.reduced(margin, 0).removeFromTop(captionHeight + 2),
+                   juce::Justification::centredLeft);
+    }
+
+    // Knob captions, above each knob.
+    g.setFont(12.0f);
+    g.setColour(juce::Colours::grey);
+
+    auto drawCaption = [&g](const Knob& knob) {
+        const auto bounds = knob.slider.getBounds();
+        g.drawText(knob.caption, bounds.withY(bounds.getY() - knobCaptionHeight).withHeight(knobCaptionHeight),
+                   juce::Justification::centred);
+    };
+
+    for (auto* knob : { &inputGain, &lowMidCrossover, &midHighCrossover, &outputGain })
+        drawCaption(*knob);
+
+    for (auto& controls : bands) {
+        drawCaption(controls.threshold);
+        drawCaption(controls.attack);
+        drawCaption(controls.release);
+
+        const auto ratio = controls.ratio.getBounds();
+        g.drawText("Ratio", ratio.withY(ratio.getY() - knobCaptionHeight).withHeight(knobCaptionHeight),
+                   juce::Justification::centredLeft);
+    }
+}
+
+//==============================================================================
+juce::Rectangle<int> Multiband_compAudioProcessorEditor::addSection(const juce::String& caption, juce::Rectangle<int> bounds)
+{
+    sections.push_back({ caption, bounds });
+    return bounds.reduced(margin).withTrimmedTop(captionHeight);
+}
+
+void Multiband_compAudioProcessorEditor::placeKnob(Knob& knob, juce::Rectangle<int> area)
+{
+    knob.slider.setBounds(area.withTrimmedTop(knobCaptionHeight));
 }
 
 void Multiband_compAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-}
\ No newline at end of file
+    sections.clear();
+    background = {};
+
+    auto area = getLocalBounds().reduced(margin);
+    auto nextRow = [&area](int height) {
+        auto row = area.removeFromTop(height);
+        area.removeFromTop(margin);
+        return row;
+    };
+
+    {
+        auto row = addSection("PRESET", nextRow(52));
+        presetBox.setBounds(row.removeFromLeft(260));
+        row.removeFromLeft(margin * 2);
+        slotA.setBounds(row.removeFromLeft(36));
+        slotB.setBounds(row.removeFromLeft(36));
+        row.removeFromLeft(margin);
+        copySlot.setBounds(row.removeFromLeft(64));
+    }
+
+    // Gains and crossovers.
+    {
+        auto row = nextRow(120);
+        const auto width = (row.getWidth() - margin) / 2;
+
+        auto gains = addSection("GAIN", row.removeFromLeft(width));
+        placeKnob(inputGain, gains.removeFromLeft(gains.getWidth() / 2));
+        placeKnob(outputGain, gains);
+
+        row.removeFromLeft(margin);
+        auto crossovers = addSection("CROSSOVER", row);
+        placeKnob(lowMidCrossover, crossovers.removeFromLeft(crossovers.getWidth() / 2));
+        placeKnob(midHighCrossover, crossovers);
+    }
+
+    // One column per band: three knobs, the ratio and the switches.
+    {
+        auto row = nextRow(190);
+        const char* names[] = { "LOW", "MID", "HIGH" };
+        const auto width = (row.getWidth() - margin * (DspStateArena::numBands - 1)) / DspStateArena::numBands;
+
+        for (int band = 0; band < DspStateArena::numBands; ++band) {
+            auto& controls = bands[(size_t)band];
+            auto column = addSection(names[band], row.removeFromLeft(width));
+            row.removeFromLeft(margin);
+
+            auto buttons = column.removeFromBottom(24);
+            const auto buttonWidth = buttons.getWidth() / 3;
+            controls.bypass.setBounds(buttons.removeFromLeft(buttonWidth).reduced(2, 0));
+            controls.mute.setBounds(buttons.removeFromLeft(buttonWidth).reduced(2, 0));
+            controls.solo.setBounds(buttons.reduced(2, 0));
+
+            column.removeFromBottom(margin);
+            auto ratio = column.removeFromBottom(24);
+            controls.ratio.setBounds(ratio.withTrimmedLeft(50));
+
+            const auto knobWidth = column.getWidth() / 3;
+            placeKnob(controls.threshold, column.removeFromLeft(knobWidth));
+            placeKnob(controls.attack, column.removeFromLeft(knobWidth));
+            placeKnob(controls.release, column);
+        }
+    }
+
+    analyser.setBounds(addSection("ANALYSER", nextRow(190)));
+    meters.setBounds(addSection("METERS", nextRow(140)));
+    loudness.setBounds(addSection("LOUDNESS", nextRow(76)));
+    performance.setBounds(addSection("PERFORMANCE", nextRow(56)));
+
+    if (StageProfiler::isEnabled())
+        profiler.setBounds(addSection("DIAGNOSTICS", area));
+}
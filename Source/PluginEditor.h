@@ -3,6 +3,16 @@
 
     This file contains the basic framework code for a JUCE plugin editor.
 
+    The native editor: every parameter, the analyser, the meters, loudness,
+    performance and (in profiling builds) diagnostics, laid out in code.
+    Opening it builds a handful of components, nothing is parsed.
+
+    Section frames, captions and knob labels never change; they are drawn
+    once into an image at the display's pixel scale, and paint() only blits
+    the part of it the repaint needs. The controls repaint when their
+    parameter moves, the live views (LiveView) at their own capped rates
+    when their data changes, and nothing at all while the editor is hidden.
+
   ==============================================================================
 */
 
@@ -10,6 +20,18 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "AnalyserPanel.h"
+#include "LoudnessPanel.h"
+#include "MeterView.h"
+#include "PerformancePanel.h"
+#include "ProfilerPanel.h"
+
+/** 1 opens the foleys layout (final_upam) instead of the native editor, to work on that
+    design; build with FOLEYS_SHOW_GUI_EDITOR_PALLETTE=1 as well for its palette.
+*/
+#ifndef MBC_ENABLE_MAGIC_EDITOR
+ #define MBC_ENABLE_MAGIC_EDITOR 0
+#endif
 
 //==============================================================================
 /**
@@ -25,9 +47,63 @@ public:
     void resized() override;
 
 private:
+    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+    using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+
+    struct Knob {
+        juce::String caption;
+        juce::Slider slider;
+        std::unique_ptr<SliderAttachment> attachment;
+    };
+
+    struct BandControls {
+        Knob threshold, attack, release;
+
+        juce::ComboBox ratio;
+        juce::TextButton bypass{ "bypass" }, mute{ "mute" }, solo{ "solo" };
+
+        std::unique_ptr<ComboBoxAttachment> ratioAttachment;
+        std::unique_ptr<ButtonAttachment> bypassAttachment, muteAttachment, soloAttachment;
+    };
+
+    struct Section {
+        juce::String caption;
+        juce::Rectangle<int> bounds;
+    };
+
+    void selectComparisonSlot(int slot);
+
+    void addKnob(Knob& knob, Params::Names parameter, const juce::String& caption, const juce::String& suffix);
+    void addToggle(juce::TextButton& button, std::unique_ptr<ButtonAttachment>& attachment, Params::Names parameter);
+
+    /** Lays the section out and returns the area inside its frame. */
+    juce::Rectangle<int> addSection(const juce::String& caption, juce::Rectangle<int> bounds);
+    static void placeKnob(Knob& knob, juce::Rectangle<int> area);
+
+    void renderBackground(float scale);
+    void drawBackground(juce::Graphics& g) const;
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     Multiband_compAudioProcessor& audioProcessor;
 
+    juce::ComboBox presetBox;
+    juce::TextButton slotA{ "A" }, slotB{ "B" }, copySlot;
+
+    Knob inputGain, lowMidCrossover, midHighCrossover, outputGain;
+    std::array<BandControls, DspStateArena::numBands> bands;
+
+    AnalyserView analyser;
+    MeterView meters;
+    LoudnessView loudness;
+    PerformanceView performance;
+    ProfilerView profiler;
+
+    std::vector<Section> sections;
+
+    juce::Image background;
+    float backgroundScale{ 0 };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Multiband_compAudioProcessorEditor)
-};
\ No newline at end of file
+};
@@ -7,7 +7,12 @@
 */
 
 #include "PluginProcessor.h"
+#include "AnalyserPanel.h"
+#include "AutomationTimeline.h"
+#include "LoudnessPanel.h"
+#include "PerformancePanel.h"
 #include "PluginEditor.h"
+#include "ProfilerPanel.h"
 
 //==============================================================================
 Multiband_compAudioProcessor::Multiband_compAudioProcessor()
@@ -23,12 +28,8 @@ Multiband_compAudioProcessor::Multiband_compAudioProcessor()
     )
 #endif
 {
-    magicState.setGuiValueTree(BinaryData::final_upam, BinaryData::final_upamSize);
-   
-    magicState.setApplicationSettingsFile(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-        .getChildFile(ProjectInfo::companyName)
-        .getChildFile(ProjectInfo::projectName + juce::String(".settings")));
-
+    // The foleys layout and its settings file are only loaded with its editor (loadGuiState),
+    // so scanning and opening sessions don't parse XML or touch the disk for every instance.
     using namespace Params;
     const auto& params = GetParams();
 
@@ -87,20 +88,27 @@ Multiband_compAudioProcessor::Multiband_compAudioProcessor()
     floatHelper(inputGainParam, Names::Gain_In);
     floatHelper(outputGainParam, Names::Gain_Out);
 
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    for (size_t i = 0; i < compressor.size(); ++i) {
+        compressor[i].index = (int)i;
+    }
+
+    // All three bands share the same choices; parsed once instead of on every block.
+    for (auto& choice : lowBandComp.ratio->choices)
+        ratioValues.push_back(choice.getFloatValue());
 
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    snapshotParameters = ParameterSnapshot::getParameters(apvts);
+    presets = PresetBank::createFactoryBank(snapshotParameters);
 
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    comparison[0].captureDefaults(snapshotParameters);
+    comparison[1] = comparison[0];
 
-    //invAP1.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    //invAP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    traceTrack = TraceRecorder::addTrack(JucePlugin_Name);
 }
 
 Multiband_compAudioProcessor::~Multiband_compAudioProcessor()
 {
+    pipeline.stop();
+    TraceRecorder::removeTrack(traceTrack);
 }
 
 //==============================================================================
@@ -143,22 +151,35 @@ double Multiband_compAudioProcessor::getTailLengthSeconds() const
 
 int Multiband_compAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presets.size());   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                                            // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int Multiband_compAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentPreset;
 }
 
 void Multiband_compAudioProcessor::setCurrentProgram(int index)
 {
+    // Hosts also select the saved program again after restoring a session; that mustn't
+    // undo the edits the session has on top of it. Any later selection loads the preset.
+    const auto restored = std::exchange(restoredPreset, -1);
+    if (index == restored)
+        return;
+
+    ParameterSnapshot snapshot;
+    if (!presets.loadInto(index, snapshot))
+        return;
+
+    snapshot.applyTo(snapshotParameters);
+    currentPreset = index;
+    updateHostDisplay();
 }
 
 const juce::String Multiband_compAudioProcessor::getProgramName(int index)
 {
-    return {};
+    return presets.getName(index);
 }
 
 void Multiband_compAudioProcessor::changeProgramName(int index, const juce::String& newName)
@@ -170,45 +191,57 @@ void Multiband_compAudioProcessor::prepareToPlay(double sampleRate, int samplesP
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
-    spec.sampleRate = sampleRate;
-
-    for (auto& comp : compressor) {
-        comp.prepare(spec);
+    const TraceRecorder::ScopedEvent traced(traceTrack, "prepareToPlay", samplesPerBlock);
+
+    // The worker may still be inside a block; it has to be gone before the engine reallocates.
+    pipeline.stop();
+
+    // Hosts also re-prepare for a new block size only, or with nothing changed. Then the
+    // engine keeps its buffers (if long enough) and filter state, and the meters keep measuring.
+    const auto numChannels = getTotalNumOutputChannels();
+    const auto sameFormat = engine.isPrepared() && sampleRate == preparedSampleRate && numChannels == preparedNumChannels;
+    preparedSampleRate = sampleRate;
+    preparedNumChannels = numChannels;
+
+    engine.prepare(sampleRate, numChannels, samplesPerBlock);
+
+    // Offline bounces spread each chunk over several cores, bit-identical to the serial path.
+    // More threads than tasks in the compressor phase (one per band and channel) would idle.
+    auto numThreads = maxRenderThreads > 0 ? maxRenderThreads : juce::SystemStats::getNumCpus();
+    numThreads = juce::jmin(numThreads, numChannels * DspStateArena::numBands);
+    engine.setNumThreads(isNonRealtime() ? numThreads : 1);
+
+    // Bounces don't adapt, they run at render quality (see updateState).
+    governor.setEnabled(isAdaptiveQuality() && !isNonRealtime());
+    governor.prepare(sampleRate);
+
+    // Offline renders gain nothing from the worker, and a bounce mustn't change the latency
+    // it was prepared with, so the mode is only decided here.
+    if (isPipelined() && !isNonRealtime()) {
+        pipeline.start(engine.getNumChannels(), samplesPerBlock,
+                       [this](float* const* channels, int numChannels, int numSamples) {
+                           processGoverned(channels, numChannels, numSamples);
+                       });
     }
 
+    setLatencySamples(pipeline.isRunning() ? pipeline.getLatencySamples() : 0);
 
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-
-    AP2.prepare(spec);
-
-    LP2.prepare(spec);
-    HP2.prepare(spec);
-
-    //invAP1.prepare(spec);
-    //invAP2.prepare(spec);
-
-    //invAPBuffer.setSize(spec.numChannels, samplesPerBlock);
-
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
-
-    inputGain.setRampDurationSeconds(0.05); //50ms
-    outputGain.setRampDurationSeconds(0.05);
-
-    for (auto& buffer : filterBuffers) {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
+    if (!sameFormat) {
+        metering.prepare(sampleRate, numChannels);
+        meterDisplay.prepare(metering.getNumChannels());
+        analyser.prepare(sampleRate);
+        inputLoudness.prepare(sampleRate);
+        outputLoudness.prepare(sampleRate);
     }
+
+    profiler.prepare(sampleRate);
 }
 
 void Multiband_compAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    pipeline.stop();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -238,51 +271,29 @@ bool Multiband_compAudioProcessor::isBusesLayoutSupported(const BusesLayout& lay
 #endif
 
 void Multiband_compAudioProcessor::updateState() {
-    for (auto& cmp : compressor)
-        cmp.updateCompressorSettings();
-
-    auto lowMidCutoffFreq = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoffFreq);
-    HP1.setCutoffFrequency(lowMidCutoffFreq);
-
+    const ScopedStage stage(*this, StageProfiler::updateState);
 
-    auto midHighCutoffFreq = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoffFreq);
-    LP2.setCutoffFrequency(midHighCutoffFreq);
-    HP2.setCutoffFrequency(midHighCutoffFreq);
+    DspEngine::Parameters parameters{};
+    parameters.low_mid_crossover_hz = lowMidCrossover->get();
+    parameters.mid_high_crossover_hz = midHighCrossover->get();
+    parameters.input_gain_db = inputGainParam->get();
+    parameters.output_gain_db = outputGainParam->get();
 
+    for (auto& cmp : compressor)
+        parameters.bands[cmp.index] = cmp.getParameters(ratioValues);
 
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
-}
-
-void Multiband_compAudioProcessor::splitBands(const juce::AudioBuffer<float>& inputBuffer) {
-
-    for (auto& fb : filterBuffers) {
-        fb = inputBuffer;
-    }
-
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
-
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
-
-    LP1.process(fb0Ctx);
-    AP2.process(fb0Ctx);
-
-    HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
-    LP2.process(fb1Ctx);
-
-    HP2.process(fb2Ctx);
+    engine.setParameters(parameters);
 
+    // Checked every block: some hosts switch to offline rendering without a new prepareToPlay.
+    // Neither configuration has latency, so nothing needs reporting when it changes.
+    engine.setQuality(isNonRealtime() ? QualityGovernor::getRenderQuality()
+                                      : QualityGovernor::getQuality(governor.getTier()));
 }
 
 void Multiband_compAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    const RealtimeGuard::ScopedAudioThread rtGuard;
+    const TraceRecorder::ScopedEvent tracedBlock(traceTrack, "processBlock", buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -296,59 +307,264 @@ void Multiband_compAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    if (!engine.isPrepared()) {
+        jassertfalse; // processBlock called before prepareToPlay
+        return;
+    }
 
-    updateState();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), engine.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    auto* const* channelData = buffer.getArrayOfWritePointers();
 
-    applyGain(buffer, inputGain);
+    if (pipeline.isRunning()) {
+        // Blocks longer than announced go through in slices of the prepared size. The output of
+        // every slice after the first comes from this block's own input, so those catch up here.
+        const auto sliceSize = pipeline.getLatencySamples();
+        float* slice[DspStateArena::maxChannels];
 
+        for (int start = 0; start < numSamples; start += sliceSize) {
+            for (int ch = 0; ch < numChannels; ++ch)
+                slice[ch] = channelData[ch] + start;
 
-    splitBands(buffer);
+            pipeline.exchange(slice, numChannels, juce::jmin(sliceSize, numSamples - start), start > 0);
+        }
+        return;
+    }
 
+    processGoverned(channelData, numChannels, numSamples);
+}
 
-    for (size_t i = 0; i < filterBuffers.size(); ++i) {
-        compressor[i].process(filterBuffers[i]);
+void Multiband_compAudioProcessor::processGoverned(float* const* channels, int numChannels, int numSamples)
+{
+    // Timed here rather than around processBlock, so the pipeline's worker measures its own
+    // blocks, on the same thread as the stages inside them.
+    const StageProfiler::ScopedBlock profiledBlock(profiler, numSamples);
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    metering.addInput(channels, numChannels, numSamples);
+    analyser.push(SpectrumAnalyser::input, channels, numChannels, numSamples);
+    inputLoudness.process(channels, numChannels, numSamples);
+
+    if (automation != nullptr) {
+        processAutomated(channels, numChannels, numSamples);
+    } else {
+        updateState();
+        processChunks(channels, numChannels, numSamples);
     }
 
+    metering.addOutput(channels, numChannels, numSamples);
+    analyser.push(SpectrumAnalyser::output, channels, numChannels, numSamples);
+    outputLoudness.process(channels, numChannels, numSamples);
+    if (metering.endBlock(numSamples))
+        meterDisplay.notifyNewFrame();
 
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
+    governor.addBlock(numSamples, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+}
 
+void Multiband_compAudioProcessor::processAutomated(float* const* channels, int numChannels, int numSamples)
+{
+    // Offline replay: the block is cut at each automation point, not the other way round.
+    float* part[DspStateArena::maxChannels];
 
-    buffer.clear();
+    for (int start = 0; start < numSamples;) {
+        const auto untilNextPoint = applyAutomation() - automationPosition;
+        const auto end = start + (int)juce::jmin((juce::int64)(numSamples - start), untilNextPoint);
 
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source) {
-        for (auto i = 0; i < nc; ++i) {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
-    };
+        updateState();
 
-    auto bandsAreSoloed = false;
-    for (auto& comp : compressor) {
-        if (comp.solo->get()) {
-            bandsAreSoloed = true;
-            break;
-        }
+        for (int ch = 0; ch < numChannels; ++ch)
+            part[ch] = channels[ch] + start;
+
+        processChunks(part, numChannels, end - start);
+
+        automationPosition += end - start;
+        start = end;
+    }
+}
+
+void Multiband_compAudioProcessor::processChunks(float* const* channels, int numChannels, int numSamples)
+{
+    // The engine's worker threads run the stages, they aren't timed one by one.
+    if (engine.getNumThreads() > 1 && isNonRealtime()) {
+        engine.process(channels, numChannels, numSamples);
+        return;
     }
 
+    // Some hosts send blocks larger than the samplesPerBlock they announced,
+    // run those through the fixed-size arena in several passes.
+    const auto maxBlockSize = engine.getMaxBlockSize();
+    float* chunk[DspStateArena::maxChannels];
 
-    if (bandsAreSoloed) {
-        for (rsize_t i = 0; i < compressor.size(); ++i) {
-            auto& comp = compressor[i];
-            if (comp.solo->get()) {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
+    for (int start = 0; start < numSamples; start += maxBlockSize) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk[ch] = channels[ch] + start;
+
+        processChunk(chunk, numChannels, juce::jmin(maxBlockSize, numSamples - start));
     }
-    else {
-        for (rsize_t i = 0; i < compressor.size(); ++i) {
-            auto& comp = compressor[i];
-            if (!comp.mute->get())
-                addFilterBand(buffer, filterBuffers[i]);
+}
+
+void Multiband_compAudioProcessor::setPipelined(bool shouldBePipelined)
+{
+    if (shouldBePipelined == isPipelined())
+        return;
+
+    apvts.state.setProperty("pipelined", shouldBePipelined, nullptr);
+
+    // Report the latency the mode will have; hosts re-prepare on a latency change, which
+    // starts or stops the worker. A host that doesn't still gets it at its next prepareToPlay.
+    setLatencySamples(shouldBePipelined && !isNonRealtime() ? juce::jmax(0, getBlockSize()) : 0);
+    updateHostDisplay(ChangeDetails().withLatencyChanged(true));
+}
+
+bool Multiband_compAudioProcessor::isPipelined() const
+{
+    return apvts.state.getProperty("pipelined", false);
+}
+
+void Multiband_compAudioProcessor::setAdaptiveQuality(bool shouldAdapt)
+{
+    apvts.state.setProperty("adaptiveQuality", shouldAdapt, nullptr);
+    governor.setEnabled(shouldAdapt && !isNonRealtime());
+}
+
+bool Multiband_compAudioProcessor::isAdaptiveQuality() const
+{
+    return apvts.state.getProperty("adaptiveQuality", true);
+}
+
+void Multiband_compAudioProcessor::resetLoudness() noexcept
+{
+    inputLoudness.requestReset();
+    outputLoudness.requestReset();
+}
+
+void Multiband_compAudioProcessor::setAutomation(const AutomationTimeline* timeline, juce::int64 startSample)
+{
+    automation = timeline;
+    nextAutomationPoint = 0;
+    automationPosition = startSample;
+
+    if (automation == nullptr)
+        return;
+
+    automatedParameters.clear();
+    for (auto& p : Params::GetParams()) {
+        if ((size_t)p.first >= automatedParameters.size())
+            automatedParameters.resize((size_t)p.first + 1);
+        automatedParameters[(size_t)p.first] = apvts.getParameter(p.second);
+    }
+
+    // Everything before startSample, so a render can start anywhere in the timeline.
+    applyAutomation();
+}
+
+juce::int64 Multiband_compAudioProcessor::applyAutomation() noexcept
+{
+    const auto& points = automation->getPoints();
+
+    for (; nextAutomationPoint < points.size(); ++nextAutomationPoint) {
+        const auto& point = points[nextAutomationPoint];
+        if (point.sample > automationPosition)
+            return point.sample;
+
+        // Straight to the parameter like a host's automation, without notifying listeners:
+        // nothing but updateState reads these during the render.
+        automatedParameters[(size_t)point.parameter]->setValue(point.normalisedValue);
+    }
+
+    return std::numeric_limits<juce::int64>::max();
+}
+
+void Multiband_compAudioProcessor::processChunk(float* const* channels, int numChannels, int numSamples)
+{
+    splitChunk(channels, numChannels, numSamples);
+    compressChunk(channels, numChannels, numSamples);
+}
+
+void Multiband_compAudioProcessor::splitChunk(float* const* channels, int numChannels, int numSamples)
+{
+    using Stage = StageProfiler::Stage;
+
+    {
+        const ScopedStage stage(*this, Stage::inputGain, numSamples);
+        engine.applyInputGain(channels, numChannels, numSamples);
+    }
+
+
+    {
+        const ScopedStage stage(*this, Stage::splitBands, numSamples);
+        engine.splitBands(channels, numChannels, numSamples);
+    }
+}
+
+void Multiband_compAudioProcessor::compressChunk(float* const* channels, int numChannels, int numSamples)
+{
+    using Stage = StageProfiler::Stage;
+
+    auto& arena = engine.getArena();
+
+    for (int band = 0; band < DspStateArena::numBands; ++band) {
+        metering.addBandInput(band, arena.getBandChannels(band), numChannels, numSamples);
+
+        {
+            const ScopedStage stage(*this, (Stage)(Stage::compressLow + band), numSamples);
+            engine.compressBand(band, numChannels, numSamples);
         }
+
+        metering.addBandOutput(band, arena.getBandChannels(band), numChannels, numSamples);
+        metering.addBandGain(band, engine.getMinGain(band, numChannels));
+    }
+
+
+    {
+        const ScopedStage stage(*this, Stage::sumBands, numSamples);
+        engine.sumBands(channels, numChannels, numSamples);
+    }
+
+
+    {
+        const ScopedStage stage(*this, Stage::outputGain, numSamples);
+        engine.applyOutputGain(channels, numChannels, numSamples);
     }
 
-    applyGain(buffer, outputGain);
+}
+
+void Multiband_compAudioProcessor::processUpToBands(juce::AudioBuffer<float>& buffer, float* const* bands)
+{
+    const RealtimeGuard::ScopedAudioThread rtGuard;
+    juce::ScopedNoDenormals noDenormals;
+
+    auto& arena = engine.getArena();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), arena.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    jassert(numSamples <= engine.getMaxBlockSize());
+
+    updateState();
+    splitChunk(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+    for (int band = 0; band < DspStateArena::numBands; ++band)
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy(bands[band * numChannels + ch], arena.getBandChannel(band, ch), numSamples);
+}
+
+void Multiband_compAudioProcessor::processFromBands(const float* const* bands, juce::AudioBuffer<float>& buffer)
+{
+    const RealtimeGuard::ScopedAudioThread rtGuard;
+    juce::ScopedNoDenormals noDenormals;
+
+    auto& arena = engine.getArena();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), arena.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    jassert(numSamples <= engine.getMaxBlockSize());
+
+    updateState();
 
+    // The compressors work in place, so each instance needs its own copy of the bands.
+    for (int band = 0; band < DspStateArena::numBands; ++band)
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy(arena.getBandChannel(band, ch), bands[band * numChannels + ch], numSamples);
+
+    compressChunk(buffer.getArrayOfWritePointers(), numChannels, numSamples);
 }
 
 //==============================================================================
@@ -357,12 +573,43 @@ bool Multiband_compAudioProcessor::hasEditor() const
 {
     return true; // (change this to false if you choose to not supply an editor)
 }
-/*
+
 juce::AudioProcessorEditor* Multiband_compAudioProcessor::createEditor()
 {
-    return new foleys::MagicPluginEditor (magicState);
-    //return new Multiband_compAudioProcessorEditor(*this);
-}*/
+#if MBC_ENABLE_MAGIC_EDITOR
+    loadGuiState();
+    return foleys::MagicProcessor::createEditor();
+#else
+    return new Multiband_compAudioProcessorEditor(*this);
+#endif
+}
+
+void Multiband_compAudioProcessor::loadGuiState()
+{
+    if (guiStateLoaded)
+        return;
+
+    guiStateLoaded = true;
+
+    magicState.setGuiValueTree(BinaryData::final_upam, BinaryData::final_upamSize);
+
+    magicState.setApplicationSettingsFile(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile(ProjectInfo::companyName)
+        .getChildFile(ProjectInfo::projectName + juce::String(".settings")));
+
+    // The diagnostics panel in final_upam is only shown in profiling builds.
+    magicState.getPropertyAsValue("diagnostics:visible").setValue(StageProfiler::isEnabled());
+}
+
+void Multiband_compAudioProcessor::initialiseBuilder(foleys::MagicGUIBuilder& builder)
+{
+    foleys::MagicProcessor::initialiseBuilder(builder);
+
+    builder.registerFactory("StageProfiler", &ProfilerPanel::factory);
+    builder.registerFactory("Performance", &PerformancePanel::factory);
+    builder.registerFactory("Analyser", &AnalyserPanel::factory);
+    builder.registerFactory("Loudness", &LoudnessPanel::factory);
+}
 
 
 
@@ -372,8 +619,14 @@ void Multiband_compAudioProcessor::getStateInformation(juce::MemoryBlock& destDa
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+
+    // The compact blob (see ParameterSnapshot), a hundred-odd bytes per instance and undo step.
+    ParameterSnapshot snapshot;
+    snapshot.capture(snapshotParameters);
+
+    const auto flags = (isPipelined() ? pipelinedFlag : 0) | (isAdaptiveQuality() ? adaptiveQualityFlag : 0)
+                     | (currentPreset << programShift);
+    snapshot.writeState(destData, (juce::uint32)flags);
 }
 
 void Multiband_compAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
@@ -381,11 +634,54 @@ void Multiband_compAudioProcessor::setStateInformation(const void* data, int siz
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
 
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-    if (tree.isValid()) {
-        apvts.replaceState(tree);
+    // Anything the state doesn't mention keeps its value, as replaceState used to.
+    ParameterSnapshot snapshot;
+    snapshot.capture(snapshotParameters);
+    juce::uint32 flags = 0;
+
+    if (ParameterSnapshot::isState(data, (size_t)sizeInBytes)) {
+        if (!snapshot.readState(data, (size_t)sizeInBytes, flags))
+            return;
+    }
+    else {
+        // Sessions saved before the blob have the APVTS tree.
+        const auto tree = juce::ValueTree::readFromData(data, (size_t)sizeInBytes);
+        if (!tree.isValid() || !tree.hasType(apvts.state.getType()))
+            return;
+
+        snapshot.readTree(tree, snapshotParameters);
+        flags = (tree.getProperty("pipelined", false) ? pipelinedFlag : 0)
+              | (tree.getProperty("adaptiveQuality", true) ? adaptiveQualityFlag : 0);
     }
 
+    snapshot.applyTo(snapshotParameters);
+    setPipelined((flags & pipelinedFlag) != 0);
+    setAdaptiveQuality((flags & adaptiveQualityFlag) != 0);
+
+    // Sessions saved before the index was stored come back as program 0.
+    const auto program = (int)(flags >> programShift);
+    currentPreset = program < presets.size() ? program : 0;
+    restoredPreset = currentPreset;
+    updateHostDisplay();
+
+    comparison.fill(snapshot);
+    comparisonSlot = 0;
+}
+
+void Multiband_compAudioProcessor::setComparisonSlot(int slot)
+{
+    jassert(slot == 0 || slot == 1);
+    if (slot == comparisonSlot)
+        return;
+
+    comparison[(size_t)comparisonSlot].capture(snapshotParameters);
+    comparison[(size_t)slot].applyTo(snapshotParameters);
+    comparisonSlot = slot;
+}
+
+void Multiband_compAudioProcessor::copyToOtherComparisonSlot()
+{
+    comparison[(size_t)(1 - comparisonSlot)].capture(snapshotParameters);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout Multiband_compAudioProcessor::createParameterLayout() {
@@ -13,6 +13,18 @@
 #include <JuceHeader.h>
 #include <vector>
 
+#include "BlockPipeline.h"
+#include "DspEngine.h"
+#include "LoudnessMeter.h"
+#include "Metering.h"
+#include "PresetBank.h"
+#include "QualityGovernor.h"
+#include "RealtimeGuard.h"
+#include "SpectrumAnalyser.h"
+#include "StageProfiler.h"
+#include "TraceRecorder.h"
+
+class AutomationTimeline;
 
 
 namespace Params {
@@ -110,33 +122,24 @@ struct CompressorBand {
     juce::AudioParameterBool* mute{ nullptr };
     juce::AudioParameterBool* solo{ nullptr };
 
+    // Which band of the DspEngine this compressor's parameters drive.
+    int index{ 0 };
 
-    void prepare(const juce::dsp::ProcessSpec& spec) {
-        compressor.prepare(spec);
-    }
 
-    void updateCompressorSettings() {
+    /** ratioValues: the ratio choices as numbers, indexed like the choice parameter. */
+    DspEngine::BandParameters getParameters(const std::vector<float>& ratioValues) const {
 
-        compressor.setAttack(attack->get());
-        compressor.setRelease(release->get());
-        compressor.setThreshold(threshold->get());
-        compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+        DspEngine::BandParameters p{};
+        p.threshold_db = threshold->get();
+        p.ratio = ratioValues[(size_t)ratio->getIndex()];
+        p.attack_ms = attack->get();
+        p.release_ms = release->get();
+        p.bypassed = bypassed->get() ? 1 : 0;
+        p.mute = mute->get() ? 1 : 0;
+        p.solo = solo->get() ? 1 : 0;
+        return p;
 
     }
-
-    void process(juce::AudioBuffer<float>& buffer) {
-
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto context = juce::dsp::ProcessContextReplacing<float>(block);
-
-        context.isBypassed = bypassed->get();
-
-        compressor.process(context);
-
-    }
-
-private:
-    juce::dsp::Compressor<float> compressor;
 };
 
 //==============================================================================
@@ -162,7 +165,7 @@ public:
 
     //==============================================================================
 
-    //juce::AudioProcessorEditor* createEditor() override;
+    juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
 
 
@@ -194,6 +197,95 @@ public:
 
     APVTS apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
+    // Stage timings for the diagnostics panel, empty unless built with MBC_ENABLE_PROFILER.
+    const StageProfiler& getProfiler() const { return profiler; }
+    StageProfiler& getProfiler() { return profiler; }
+
+    // Level, band and gain reduction bars for the editor's meters, updated on the message thread.
+    MeterDisplay& getMeterDisplay() noexcept { return meterDisplay; }
+
+    void initialiseBuilder(foleys::MagicGUIBuilder& builder) override;
+
+    //==============================================================================
+    // Parameter sweeps (Cli/SweepRenderer): one instance runs the input gain and the
+    // crossover, any number of others compress and sum the bands it produced, each
+    // with its own settings. Both sides must be prepared with the same channel count
+    // and blocks must fit the prepared block size. bands[band * numChannels + channel].
+
+    /** Input gain and crossover only; the bands are copied out, buffer is left with the gained input. */
+    void processUpToBands(juce::AudioBuffer<float>& buffer, float* const* bands);
+
+    /** Compressors, band sum and output gain on bands from another instance's processUpToBands. */
+    void processFromBands(const float* const* bands, juce::AudioBuffer<float>& buffer);
+
+    //==============================================================================
+    /** Offline renders (Cli/): replays the timeline from startSample on, counting the samples
+        of the following processBlock calls. Points before startSample are applied at once.
+        Call after prepareToPlay, not while processing; the timeline must outlive the replay
+        and nullptr stops it.
+    */
+    void setAutomation(const AutomationTimeline* timeline, juce::int64 startSample = 0);
+
+    /** Cores one instance may use while isNonRealtime(), from the next prepareToPlay on.
+        0 (the default) uses every core; 1 keeps it on the host's thread, for tools that
+        already render several files at once. Real-time processing is always serial.
+    */
+    void setMaxRenderThreads(int numThreads) { maxRenderThreads = numThreads; }
+
+    //==============================================================================
+    /** Opt-in pipelined mode (see BlockPipeline): processBlock only trades buffers with a
+        worker thread of this instance, which runs the chain one prepared block later,
+        reported as latency. Saved with the state. A change reports the new latency at once,
+        which makes hosts re-prepare; the worker starts or stops at that prepareToPlay, and
+        only runs for real-time processing.
+    */
+    void setPipelined(bool shouldBePipelined);
+    bool isPipelined() const;
+
+    /** Whether the current prepareToPlay started the worker. */
+    bool isPipelineRunning() const noexcept { return pipeline.isRunning(); }
+    juce::int64 getNumPipelineUnderruns() const noexcept { return pipeline.getNumUnderruns(); }
+
+    //==============================================================================
+    /** Lets the QualityGovernor trade precision for CPU when real-time blocks run close to
+        their deadline (on by default, saved with the state). Offline renders always run
+        at render quality (QualityGovernor::getRenderQuality), whatever this says.
+    */
+    void setAdaptiveQuality(bool shouldAdapt);
+    bool isAdaptiveQuality() const;
+
+    /** The QualityGovernor tier real-time processing holds while adaptive quality is off,
+        full unless set. Not saved; for tools that check one tier at a time.
+    */
+    void setFixedQualityTier(int tier) noexcept { governor.setFixedTier(tier); }
+
+    const QualityGovernor& getQualityGovernor() const noexcept { return governor; }
+
+    //==============================================================================
+    /** A/B comparison, on the message thread. Each slot holds a full set of parameter values;
+        switching stores the current ones in the active slot and recalls the other, setting
+        only the parameters that differ. Both start as the state last loaded (or the defaults).
+    */
+    void setComparisonSlot(int slot);
+    int getComparisonSlot() const noexcept { return comparisonSlot; }
+
+    /** Puts the current values in the other slot too. */
+    void copyToOtherComparisonSlot();
+
+    /** The factory presets, which are also the programs the host sees. */
+    const PresetBank& getPresets() const noexcept { return presets; }
+
+    /** BS.1770 loudness and true peak of the input and the output since the last reset
+        (or prepareToPlay); any thread.
+    */
+    LoudnessMeter::Reading getInputLoudness() const noexcept { return inputLoudness.getReading(); }
+    LoudnessMeter::Reading getOutputLoudness() const noexcept { return outputLoudness.getReading(); }
+
+    /** Any thread; both meters start over with the next block. */
+    void resetLoudness() noexcept;
+
+    /** Input and output spectrum for the editor; idle unless an AnalyserPanel is open. */
+    SpectrumAnalyser& getAnalyser() noexcept { return analyser; }
     
 
 private:
@@ -204,34 +296,84 @@ private:
     CompressorBand& highBandComp = compressor[2];
 
 
-    using  Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    // fc0  fc1
-    Filter  LP1, AP2,
-        HP1, LP2,
-        HP2;
-    //saturation 
-
-
     juce::AudioParameterFloat* lowMidCrossover{ nullptr };
     juce::AudioParameterFloat* midHighCrossover{ nullptr };
 
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
-
-    juce::dsp::Gain<float> inputGain, outputGain;
     juce::AudioParameterFloat* inputGainParam{ nullptr };
     juce::AudioParameterFloat* outputGainParam{ nullptr };
 
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain) {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
-    }
+    // The processing chain itself (also usable without the plugin, see mbc_core.h);
+    // this class only feeds it the parameters and times its stages.
+    DspEngine engine;
+    std::vector<float> ratioValues;
+    int maxRenderThreads{ 0 };
+
+    // Every parameter in Names order, for state, presets and A/B (see ParameterSnapshot).
+    ParameterSnapshot::Parameters snapshotParameters{};
+    PresetBank presets;
+    int currentPreset{ 0 };
+    int restoredPreset{ -1 };       // until the host's first setCurrentProgram after a restore
+    std::array<ParameterSnapshot, 2> comparison;
+    int comparisonSlot{ 0 };
+
+    // Settings that are saved with the state but aren't parameters; the program index
+    // goes in the upper half.
+    enum StateFlags {
+        pipelinedFlag = 1 << 0,
+        adaptiveQualityFlag = 1 << 1,
+        programShift = 16
+    };
+
+    // What the last prepareToPlay was for, to tell a real format change from a new block size.
+    double preparedSampleRate{ 0 };
+    int preparedNumChannels{ 0 };
+
+    QualityGovernor governor;
+
+    // Declared after the engine: the worker must stop before what it processes goes away.
+    BlockPipeline pipeline;
+
+    // Automation replay, see setAutomation. automatedParameters is indexed by Params::Names.
+    const AutomationTimeline* automation{ nullptr };
+    size_t nextAutomationPoint{ 0 };
+    juce::int64 automationPosition{ 0 };
+    std::vector<juce::RangedAudioParameter*> automatedParameters;
+
+    // Audio-thread side of the meters and what the editor's sources read from it.
+    Metering metering;
+    MeterDisplay meterDisplay{ metering, magicState };
+    SpectrumAnalyser analyser;
+    LoudnessMeter inputLoudness, outputLoudness;
+
+    StageProfiler profiler;
+    int traceTrack{ 0 };
+
+    /** Times one stage for the profiler and the trace timeline; compiles to nothing unless one is enabled. */
+    struct ScopedStage {
+        ScopedStage(Multiband_compAudioProcessor& p, StageProfiler::Stage stage, int numSamples = 0) noexcept
+            : profiled(p.profiler, stage), traced(p.traceTrack, StageProfiler::getStageName(stage), numSamples) {}
+
+        const StageProfiler::ScopedStage profiled;
+        const TraceRecorder::ScopedEvent traced;
+    };
+
+    /** The foleys layout and settings file, on the first editor that needs them. */
+    void loadGuiState();
+    bool guiStateLoaded{ false };
 
     void updateState();
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+    juce::int64 applyAutomation() noexcept;
+    void processGoverned(float* const* channels, int numChannels, int numSamples);
+    void processAutomated(float* const* channels, int numChannels, int numSamples);
+    void processChunks(float* const* channels, int numChannels, int numSamples);
+    void processChunk(float* const* channels, int numChannels, int numSamples);
+    void splitChunk(float* const* channels, int numChannels, int numSamples);
+    void compressChunk(float* const* channels, int numChannels, int numSamples);
     
     //foleys::MagicProcessorState magicState;
+
+    // Lets the offline tools (Benchmarks/) time the individual stages.
+    friend struct ProcessorProbe;
    
     
     //==============================================================================
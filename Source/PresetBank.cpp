@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+#include "PluginProcessor.h"
+
+PresetBank PresetBank::createFactoryBank(const ParameterSnapshot::Parameters& parameters) {
+    using namespace Params;
+
+    // The ratio parameters store the index of the choice.
+    auto* ratioChoice = dynamic_cast<juce::AudioParameterChoice*>(parameters[Ratio_Low_Band]);
+    jassert(ratioChoice != nullptr);
+
+    auto ratio = [ratioChoice](float value) {
+        return (float)juce::jmax(0, ratioChoice->choices.indexOf(juce::String(value, 1)));
+    };
+
+    struct Band {
+        float threshold, ratio, attack, release;
+    };
+
+    ParameterSnapshot defaults;
+    defaults.captureDefaults(parameters);
+
+    auto makePreset = [&](float lowMid, float midHigh, const Band& low, const Band& mid, const Band& high) {
+        auto snapshot = defaults;
+        snapshot.set(Low_Mid_Crossover_Freq, lowMid);
+        snapshot.set(Mid_High_Crossover_Freq, midHigh);
+
+        const Band* bands[] = { &low, &mid, &high };
+        for (int band = 0; band < DspStateArena::numBands; ++band) {
+            snapshot.set(Threshold_Low_Band + band, bands[band]->threshold);
+            snapshot.set(Ratio_Low_Band + band, ratio(bands[band]->ratio));
+            snapshot.set(Attack_Low_Band + band, bands[band]->attack);
+            snapshot.set(Release_Low_Band + band, bands[band]->release);
+        }
+
+        return snapshot;
+    };
+
+    PresetBank bank;
+    bank.add("Default", defaults);
+    bank.add("Gentle Glue", makePreset(400, 2000, { -18, 2, 30, 200 }, { -18, 2, 30, 200 }, { -18, 2, 30, 200 }));
+    bank.add("Tight Low End", makePreset(150, 2000, { -24, 4, 10, 120 }, { -12, 1.5f, 30, 200 }, { -12, 1.5f, 30, 200 }));
+    bank.add("Vocal Control", makePreset(250, 4000, { -12, 1.5f, 50, 250 }, { -20, 3, 15, 150 }, { -24, 4, 5, 80 }));
+    bank.add("Mastering", makePreset(200, 5000, { -12, 1.5f, 50, 300 }, { -12, 1.5f, 50, 300 }, { -12, 1.5f, 30, 250 }));
+    return bank;
+}
+
+void PresetBank::add(const juce::String& name, const ParameterSnapshot& snapshot) {
+    presets.push_back({ name, snapshot });
+}
+
+juce::String PresetBank::getName(int index) const {
+    return juce::isPositiveAndBelow(index, size()) ? presets[(size_t)index].name : juce::String();
+}
+
+bool PresetBank::loadInto(int index, ParameterSnapshot& destination) const noexcept {
+    if (!juce::isPositiveAndBelow(index, size()))
+        return false;
+
+    destination = presets[(size_t)index].snapshot;
+    return true;
+}
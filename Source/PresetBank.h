@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 19 Oct 2026
+
+    Named ParameterSnapshots, the plugin's programs. Built once with the
+    processor; loading one copies its values into a snapshot the caller
+    already has, so recalling a preset allocates nothing and parses nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterSnapshot.h"
+
+class PresetBank {
+public:
+    /** The defaults first, then a few starting points. */
+    static PresetBank createFactoryBank(const ParameterSnapshot::Parameters& parameters);
+
+    void add(const juce::String& name, const ParameterSnapshot& snapshot);
+
+    int size() const noexcept { return (int)presets.size(); }
+
+    /** Empty for an index out of range. */
+    juce::String getName(int index) const;
+
+    /** Copies the preset's values into destination; false if there is no such preset. */
+    bool loadInto(int index, ParameterSnapshot& destination) const noexcept;
+
+private:
+    struct Preset {
+        juce::String name;
+        ParameterSnapshot snapshot;
+    };
+
+    std::vector<Preset> presets;
+};
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    ProfilerPanel.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ProfilerPanel.h"
+#include "PluginProcessor.h"
+
+namespace {
+    StageProfiler* findProfiler(foleys::MagicGUIBuilder& builder) {
+        if (auto* processor = dynamic_cast<Multiband_compAudioProcessor*>(builder.getMagicState().getProcessor()))
+            return &processor->getProfiler();
+        return nullptr;
+    }
+}
+
+//==============================================================================
+ProfilerView::ProfilerView(StageProfiler* profilerToShow)
+    : LiveView(5), profiler(profilerToShow) {
+
+    if (StageProfiler::isEnabled() && profiler != nullptr)
+        startRefreshing();
+}
+
+void ProfilerView::refresh() {
+    snapshot = profiler->getSnapshot();
+    repaint();
+}
+
+void ProfilerView::mouseDoubleClick(const juce::MouseEvent&) {
+    if (profiler != nullptr)
+        profiler->reset();
+}
+
+void ProfilerView::paint(juce::Graphics& g) {
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(4);
+
+    if (!StageProfiler::isEnabled() || profiler == nullptr) {
+        g.drawText("Profiling is not compiled into this build (MBC_ENABLE_PROFILER)", area, juce::Justification::centred);
+        return;
+    }
+
+    const auto rowHeight = 15;
+    auto row = [&] { return area.removeFromTop(rowHeight); };
+    auto percent = [](double x) { return juce::String(x * 100.0, 1) + "%"; };
+    auto us = [](double x) { return juce::String(x, 2); };
+
+    auto drawColumns = [&g](juce::Rectangle<int> r, std::initializer_list<juce::String> texts) {
+        const auto width = r.getWidth() / (int)texts.size();
+        for (auto& text : texts)
+            g.drawText(text, r.removeFromLeft(width), juce::Justification::centredLeft);
+    };
+
+    drawColumns(row(), { "load: mean " + percent(snapshot.meanLoad),
+                         "p99 " + percent(snapshot.p99Load),
+                         "max " + percent(snapshot.maxLoad),
+                         "headroom " + percent(snapshot.headroom()),
+                         juce::String(snapshot.numBlocks) + " blocks" });
+
+    g.setColour(juce::Colours::grey);
+    drawColumns(row(), { "stage", "cpu share", "mean us", "p99 us", "max us" });
+
+    for (int s = 0; s < StageProfiler::numStages; ++s) {
+        const auto& stats = snapshot.stages[(size_t)s];
+
+        // The worst offender stands out.
+        g.setColour(s != StageProfiler::block && stats.cpuShare > 0.4 ? juce::Colours::orange : juce::Colours::white);
+        drawColumns(row(), { StageProfiler::getStageName((StageProfiler::Stage)s),
+                             percent(stats.cpuShare), us(stats.meanMicroseconds),
+                             us(stats.p99Microseconds), us(stats.maxMicroseconds) });
+    }
+}
+
+//==============================================================================
+ProfilerPanel::ProfilerPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node)
+    : foleys::GuiItem(builder, node), view(findProfiler(builder)) {
+
+    addAndMakeVisible(view);
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    ProfilerPanel.h
+    Created: 19 Oct 2026
+
+    Diagnostics panel of the editor: per-stage CPU share, mean/p99/max time
+    and deadline headroom of this instance, from its StageProfiler.
+    Registered with the foleys builder as <StageProfiler/>; double-click
+    it to reset the histograms.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "LiveView.h"
+#include "StageProfiler.h"
+
+class ProfilerView : public LiveView {
+public:
+    explicit ProfilerView(StageProfiler* profilerToShow);
+
+    void paint(juce::Graphics& g) override;
+    void mouseDoubleClick(const juce::MouseEvent&) override;
+
+private:
+    void refresh() override;
+
+    StageProfiler* profiler;
+    StageProfiler::Snapshot snapshot;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerView)
+};
+
+class ProfilerPanel : public foleys::GuiItem {
+public:
+    FOLEYS_DECLARE_GUI_FACTORY(ProfilerPanel)
+
+    ProfilerPanel(foleys::MagicGUIBuilder& builder, const juce::ValueTree& node);
+
+    void update() override {}
+    juce::Component* getWrappedComponent() override { return &view; }
+
+private:
+    ProfilerView view;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerPanel)
+};
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+DspEngine::Quality QualityGovernor::getQuality(int t) noexcept {
+    switch (t) {
+        case detectorEvery4:    return { 4, false };
+        case detectorEvery16:   return { 16, false };
+        case complementary:     return { 16, true };
+        default:                return { 1, false };
+    }
+}
+
+const char* QualityGovernor::getTierName(int t) noexcept {
+    switch (t) {
+        case full:              return "full";
+        case detectorEvery4:    return "detector / 4";
+        case detectorEvery16:   return "detector / 16";
+        case complementary:     return "complementary split";
+        default:                return "";
+    }
+}
+
+void QualityGovernor::prepare(double newSampleRate) noexcept {
+    sampleRate = newSampleRate;
+    load = 0;
+    secondsSinceChange = 0;
+    secondsBelowStepUp = 0;
+    recoverySeconds = minRecoverySeconds;
+    lastChangeWasUp = false;
+
+    smoothedLoad.store(0, std::memory_order_relaxed);
+    tier.store(isEnabled() ? (int)full : fixedTier.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void QualityGovernor::setEnabled(bool shouldBeEnabled) noexcept {
+    enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+void QualityGovernor::setFixedTier(int newTier) noexcept {
+    jassert(juce::isPositiveAndBelow(newTier, (int)numTiers));
+    fixedTier.store(newTier, std::memory_order_relaxed);
+}
+
+void QualityGovernor::addBlock(int numSamples, double seconds) noexcept {
+    if (numSamples <= 0)
+        return;
+
+    const auto blockSeconds = numSamples / sampleRate;
+    const auto blockLoad = seconds / blockSeconds;
+
+    // One-pole smoothing in time rather than per block, so the block size doesn't change the response.
+    load += (1.0 - std::exp(-blockSeconds / smoothingSeconds)) * (blockLoad - load);
+    smoothedLoad.store((float)load, std::memory_order_relaxed);
+
+    const auto current = getTier();
+
+    if (!isEnabled()) {
+        const auto fixed = fixedTier.load(std::memory_order_relaxed);
+        if (current != fixed)
+            setTier(fixed);
+        return;
+    }
+
+    secondsSinceChange += blockSeconds;
+
+    if ((load > stepDownLoad || blockLoad > spikeLoad) && current < numTiers - 1 && secondsSinceChange >= holdSeconds) {
+        // Stepping straight back down after a recovery: that tier was too much, wait longer next time.
+        if (lastChangeWasUp && secondsSinceChange < recoverySeconds)
+            recoverySeconds = juce::jmin(maxRecoverySeconds, recoverySeconds * 2.0);
+
+        lastChangeWasUp = false;
+        setTier(current + 1);
+        return;
+    }
+
+    secondsBelowStepUp = load < stepUpLoad ? secondsBelowStepUp + blockSeconds : 0.0;
+
+    if (current > full && secondsBelowStepUp >= recoverySeconds) {
+        lastChangeWasUp = true;
+        setTier(current - 1);
+        return;
+    }
+
+    // A tier that has held for a long time says nothing about the next recovery.
+    if (secondsSinceChange > maxRecoverySeconds)
+        recoverySeconds = minRecoverySeconds;
+}
+
+void QualityGovernor::setTier(int newTier) noexcept {
+    tier.store(newTier, std::memory_order_relaxed);
+    numTierChanges.store(numTierChanges.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    secondsSinceChange = 0;
+    secondsBelowStepUp = 0;
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 19 Oct 2026
+
+    Watches how long each real-time block takes against its deadline and,
+    when the machine gets short of CPU, steps the DspEngine down through
+    cheaper quality tiers rather than letting the host drop out. Steps back
+    up once the load has stayed low for a while; a tier that keeps
+    bouncing waits longer each time before trying again.
+
+    The audio thread writes, the editor (PerformancePanel) reads the tier
+    and the smoothed load whenever it likes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DspEngine.h"
+
+class QualityGovernor {
+public:
+    enum Tier {
+        full,               // per-sample detector, LR4 split
+        detectorEvery4,
+        detectorEvery16,
+        complementary,      // detector every 16 samples, complementary split
+
+        numTiers
+    };
+
+    static DspEngine::Quality getQuality(int tier) noexcept;
+    static const char* getTierName(int tier) noexcept;
+
+    /** What non-realtime renders run instead: above full, with the oversampled detector. */
+    static DspEngine::Quality getRenderQuality() noexcept { return { 1, false, true }; }
+
+    /** Back to full quality with no history. Call from prepareToPlay. */
+    void prepare(double sampleRate) noexcept;
+
+    /** While disabled the tier stays at the fixed one; real-time safe. */
+    void setEnabled(bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /** The tier held while disabled, full unless set. Taken at the next prepare or block;
+        real-time safe. For checking one tier at a time (EquivalenceHarness).
+    */
+    void setFixedTier(int newTier) noexcept;
+
+    /** Audio thread, once per block: how long the chain took for numSamples. */
+    void addBlock(int numSamples, double seconds) noexcept;
+
+    int getTier() const noexcept { return tier.load(std::memory_order_relaxed); }
+    float getLoad() const noexcept { return smoothedLoad.load(std::memory_order_relaxed); }
+    juce::int64 getNumTierChanges() const noexcept { return numTierChanges.load(std::memory_order_relaxed); }
+
+private:
+    // Fractions of the block's duration.
+    static constexpr double stepDownLoad = 0.6;     // smoothed
+    static constexpr double spikeLoad = 0.9;        // a single block
+    static constexpr double stepUpLoad = 0.3;
+
+    static constexpr double smoothingSeconds = 0.3;
+    static constexpr double holdSeconds = 0.1;      // after a change, before stepping down again
+    static constexpr double minRecoverySeconds = 2.0;
+    static constexpr double maxRecoverySeconds = 32.0;
+
+    void setTier(int newTier) noexcept;
+
+    std::atomic<bool> enabled{ true };
+    std::atomic<int> fixedTier{ full };
+    std::atomic<int> tier{ full };
+    std::atomic<float> smoothedLoad{ 0 };
+    std::atomic<juce::int64> numTierChanges{ 0 };
+
+    // Audio thread only.
+    double sampleRate{ 44100.0 };
+    double load{ 0 };
+    double secondsSinceChange{ 0 };
+    double secondsBelowStepUp{ 0 };
+    double recoverySeconds{ minRecoverySeconds };
+    bool lastChangeWasUp{ false };
+};
@@ -0,0 +1,347 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#if MBC_ENABLE_RT_GUARD
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <malloc.h>
+ #include <mutex>
+ #include <pthread.h>
+ #define MBC_RT_GUARD_TLS __attribute__((tls_model("initial-exec")))
+#else
+ #define MBC_RT_GUARD_TLS
+#endif
+
+#if JUCE_WINDOWS && defined (_DEBUG)
+ #include <crtdbg.h>
+#endif
+
+namespace RealtimeGuard {
+
+    namespace {
+        // Plain int so that the TLS slot needs no dynamic initialisation: the allocation
+        // hooks below can be entered before any constructor of this file has run.
+        thread_local int audioThreadDepth MBC_RT_GUARD_TLS = 0;
+
+        // Set by selfTest, whose violations are counted without asserting.
+        thread_local bool expectingViolations MBC_RT_GUARD_TLS = false;
+
+        std::atomic<int> violationCounts[3]{};
+
+        // Whether what fn does went through one of the allocation hooks below.
+        template <typename Fn>
+        bool allocates(Fn&& fn) noexcept {
+            const auto before = violationCounts[(int)Violation::allocation].load(std::memory_order_relaxed);
+            fn();
+            return violationCounts[(int)Violation::allocation].load(std::memory_order_relaxed) > before;
+        }
+    }
+
+    ScopedAudioThread::ScopedAudioThread() noexcept { ++audioThreadDepth; }
+    ScopedAudioThread::~ScopedAudioThread() noexcept { --audioThreadDepth; }
+
+    ScopedSuspend::ScopedSuspend() noexcept : savedDepth(audioThreadDepth) { audioThreadDepth = 0; }
+    ScopedSuspend::~ScopedSuspend() noexcept { audioThreadDepth = savedDepth; }
+
+    bool isInsideAudioThread() noexcept {
+        return audioThreadDepth > 0;
+    }
+
+    void reportViolation(Violation kind) noexcept {
+        violationCounts[(int)kind].fetch_add(1, std::memory_order_relaxed);
+
+        if (expectingViolations)
+            return;
+
+        // jassert logs through juce::String, which allocates - don't trap ourselves.
+        const ScopedSuspend suspend;
+        jassertfalse;
+    }
+
+    int getNumViolations(Violation kind) noexcept {
+        return violationCounts[(int)kind].load(std::memory_order_relaxed);
+    }
+
+    void resetViolations() noexcept {
+        for (auto& count : violationCounts)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    bool selfTest() noexcept {
+        resetViolations();
+        expectingViolations = true;
+
+        auto passed = true;
+
+        {
+            const ScopedAudioThread audioThread;
+
+            // Through volatile pointers, so the compiler can't drop the pairs as unused.
+            void* (*volatile allocate)(std::size_t) = ::operator new;
+            void (*volatile release)(void*) noexcept = ::operator delete;
+            passed = allocates([&] { release(allocate(16)); });
+
+           #if JUCE_LINUX
+            // Every entry point of the malloc family is interposed on its own: HeapBlock goes
+            // through malloc, calloc and realloc, aligned operator new through aligned_alloc.
+            void* (*volatile allocateCleared)(size_t, size_t) = calloc;
+            void* (*volatile reallocate)(void*, size_t) = realloc;
+            void* (*volatile allocateAligned)(size_t, size_t) = aligned_alloc;
+            void* (*volatile allocateMemalign)(size_t, size_t) = memalign;
+            int (*volatile allocatePosixAligned)(void**, size_t, size_t) = posix_memalign;
+            void* (*volatile allocatePage)(size_t) = valloc;
+            void* (*volatile allocatePages)(size_t) = pvalloc;
+            void (*volatile releaseBlock)(void*) = free;
+
+            passed = passed
+                  && allocates([&] { releaseBlock(allocateCleared(4, 4)); })
+                  && allocates([&] { releaseBlock(reallocate(nullptr, 16)); })
+                  && allocates([&] { releaseBlock(allocateAligned(64, 64)); })
+                  && allocates([&] { releaseBlock(allocateMemalign(64, 16)); })
+                  && allocates([&] { void* ptr = nullptr; if (allocatePosixAligned(&ptr, 64, 16) == 0) releaseBlock(ptr); })
+                  && allocates([&] { releaseBlock(allocatePage(16)); })
+                  && allocates([&] { releaseBlock(allocatePages(16)); });
+
+            std::mutex mutex;
+            mutex.lock();
+            mutex.unlock();
+           #endif
+        }
+
+        expectingViolations = false;
+
+        passed = passed && getNumViolations(Violation::deallocation) > 0;
+
+       #if JUCE_LINUX
+        // Locks are only trapped here.
+        passed = passed && getNumViolations(Violation::lock) > 0;
+       #endif
+
+        resetViolations();
+        return passed;
+    }
+}
+
+using RealtimeGuard::Violation;
+
+#if JUCE_LINUX
+//==============================================================================
+// glibc: interpose the malloc family so juce::HeapBlock (and therefore AudioBuffer)
+// reallocations are caught as well as operator new, plus pthread_mutex_lock which
+// backs both std::mutex and juce::CriticalSection.
+
+extern "C" {
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void* __libc_valloc(size_t);
+    void* __libc_pvalloc(size_t);
+    void  __libc_free(void*);
+
+    void* malloc(size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t num, size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_calloc(num, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+
+        auto* ptr = __libc_memalign(alignment, size);
+        if (ptr == nullptr)
+            return ENOMEM;
+
+        *result = ptr;
+        return 0;
+    }
+
+    void* valloc(size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_valloc(size);
+    }
+
+    void* pvalloc(size_t size) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::allocation);
+        return __libc_pvalloc(size);
+    }
+
+    void free(void* ptr) noexcept {
+        if (ptr != nullptr && RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::deallocation);
+        __libc_free(ptr);
+    }
+
+    using MutexLockFn = int (*)(pthread_mutex_t*);
+
+    // Constant-initialised: locks can be taken before any static initialiser of this file runs.
+    static std::atomic<MutexLockFn> realMutexLock{ nullptr };
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+        if (RealtimeGuard::isInsideAudioThread())
+            RealtimeGuard::reportViolation(Violation::lock);
+
+        // Resolved by the first lock in the process, long before any audio thread exists.
+        // dlsym's own locking doesn't come back through here; racing threads store the same pointer.
+        auto lock = realMutexLock.load(std::memory_order_relaxed);
+        if (lock == nullptr) {
+            lock = (MutexLockFn)dlsym(RTLD_NEXT, "pthread_mutex_lock");
+            realMutexLock.store(lock, std::memory_order_relaxed);
+        }
+
+        return lock(mutex);
+    }
+}
+
+#elif JUCE_WINDOWS && defined (_DEBUG)
+//==============================================================================
+// The debug CRT already routes every malloc/new through a hook, no need to replace anything.
+// There is no equivalent for SRWLOCK/CRITICAL_SECTION, so locks are only trapped on Linux.
+
+// Whatever hook was installed before (a leak checker, say) still gets every call.
+static _CRT_ALLOC_HOOK previousAllocHook = nullptr;
+
+static int rtGuardAllocHook(int allocType, void* userData, size_t size, int blockType,
+                            long requestNumber, const unsigned char* fileName, int lineNumber) {
+    if (blockType != _CRT_BLOCK && RealtimeGuard::isInsideAudioThread())
+        RealtimeGuard::reportViolation(allocType == _HOOK_FREE ? Violation::deallocation
+                                                               : Violation::allocation);
+
+    if (previousAllocHook != nullptr)
+        return previousAllocHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber);
+
+    return TRUE;
+}
+
+static const bool allocHookInstalled = (previousAllocHook = _CrtSetAllocHook(rtGuardAllocHook), true);
+
+#else
+//==============================================================================
+// Everywhere else fall back to replacing the global operator new/delete.
+
+static void* guardedAlloc(std::size_t size) {
+    if (RealtimeGuard::isInsideAudioThread())
+        RealtimeGuard::reportViolation(Violation::allocation);
+
+    return std::malloc(size != 0 ? size : 1);
+}
+
+static void* guardedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+    if (RealtimeGuard::isInsideAudioThread())
+        RealtimeGuard::reportViolation(Violation::allocation);
+
+   #if JUCE_WINDOWS
+    return _aligned_malloc(size != 0 ? size : 1, (std::size_t)alignment);
+   #else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, juce::jmax(sizeof(void*), (std::size_t)alignment), size != 0 ? size : 1) == 0 ? ptr : nullptr;
+   #endif
+}
+
+static void guardedFree(void* ptr) noexcept {
+    if (ptr != nullptr && RealtimeGuard::isInsideAudioThread())
+        RealtimeGuard::reportViolation(Violation::deallocation);
+
+    std::free(ptr);
+}
+
+static void guardedAlignedFree(void* ptr) noexcept {
+   #if JUCE_WINDOWS
+    if (ptr != nullptr && RealtimeGuard::isInsideAudioThread())
+        RealtimeGuard::reportViolation(Violation::deallocation);
+
+    _aligned_free(ptr);
+   #else
+    guardedFree(ptr);
+   #endif
+}
+
+void* operator new(std::size_t size) {
+    if (auto* ptr = guardedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (auto* ptr = guardedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (auto* ptr = guardedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (auto* ptr = guardedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return guardedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return guardedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return guardedAlignedAlloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return guardedAlignedAlloc(size, alignment); }
+
+void operator delete(void* ptr) noexcept { guardedFree(ptr); }
+void operator delete[](void* ptr) noexcept { guardedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { guardedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { guardedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { guardedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { guardedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { guardedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { guardedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { guardedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { guardedAlignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { guardedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { guardedAlignedFree(ptr); }
+
+#endif
+
+#endif // MBC_ENABLE_RT_GUARD
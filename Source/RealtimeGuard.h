@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 19 Oct 2026
+
+    Debug/test helper that traps heap allocations and mutex locks taken while
+    the audio thread is inside processBlock.
+
+    Enable with MBC_ENABLE_RT_GUARD=1 (set for the Debug configuration in the
+    .jucer). When disabled everything here compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MBC_ENABLE_RT_GUARD
+ #define MBC_ENABLE_RT_GUARD 0
+#endif
+
+namespace RealtimeGuard {
+
+    enum class Violation
+    {
+        allocation,
+        deallocation,
+        lock
+    };
+
+#if MBC_ENABLE_RT_GUARD
+    /** Marks the current thread as running real-time code for the lifetime of the object.
+        Any allocation, deallocation or mutex lock made in that scope is counted and asserts.
+    */
+    struct ScopedAudioThread {
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+
+    /** Temporarily lifts the guard, e.g. for code that is allowed to allocate on the audio thread. */
+    struct ScopedSuspend {
+        ScopedSuspend() noexcept;
+        ~ScopedSuspend() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSuspend)
+    private:
+        int savedDepth;
+    };
+
+    bool isInsideAudioThread() noexcept;
+    void reportViolation(Violation) noexcept;
+
+    int getNumViolations(Violation) noexcept;
+    void resetViolations() noexcept;
+
+    /** Allocates, frees and (on Linux) locks inside a ScopedAudioThread, without asserting,
+        and checks each was counted; on Linux every interposed allocation call separately.
+        Leaves the counts at zero.
+    */
+    bool selfTest() noexcept;
+#else
+    struct ScopedAudioThread { ScopedAudioThread() noexcept {} };
+    struct ScopedSuspend { ScopedSuspend() noexcept {} };
+
+    inline bool isInsideAudioThread() noexcept { return false; }
+    inline void reportViolation(Violation) noexcept {}
+
+    inline int getNumViolations(Violation) noexcept { return 0; }
+    inline void resetViolations() noexcept {}
+
+    inline bool selfTest() noexcept { return true; }
+#endif
+
+    constexpr bool isEnabled() noexcept { return MBC_ENABLE_RT_GUARD != 0; }
+}
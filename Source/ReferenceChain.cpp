@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    ReferenceChain.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ReferenceChain.h"
+
+ReferenceChain::ReferenceChain() {
+    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+
+    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+
+    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
+    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+}
+
+void ReferenceChain::prepare(double sampleRate, int numChannels, int samplesPerBlock) {
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = samplesPerBlock;
+    spec.numChannels = numChannels;
+    spec.sampleRate = sampleRate;
+
+    for (auto& comp : compressor) {
+        comp.prepare(spec);
+    }
+
+    LP1.prepare(spec);
+    HP1.prepare(spec);
+
+    AP2.prepare(spec);
+
+    LP2.prepare(spec);
+    HP2.prepare(spec);
+
+    inputGain.prepare(spec);
+    outputGain.prepare(spec);
+
+    inputGain.setRampDurationSeconds(0.05); //50ms
+    outputGain.setRampDurationSeconds(0.05);
+
+    for (auto& buffer : filterBuffers) {
+        buffer.setSize(spec.numChannels, samplesPerBlock);
+    }
+}
+
+void ReferenceChain::updateState(const ChainSettings& settings) {
+    for (size_t i = 0; i < compressor.size(); ++i) {
+        auto& band = settings.bands[i];
+        compressor[i].setAttack(band.attack);
+        compressor[i].setRelease(band.release);
+        compressor[i].setThreshold(band.threshold);
+        compressor[i].setRatio(band.ratio);
+    }
+
+    LP1.setCutoffFrequency(settings.lowMidCrossover);
+    HP1.setCutoffFrequency(settings.lowMidCrossover);
+
+    AP2.setCutoffFrequency(settings.midHighCrossover);
+    LP2.setCutoffFrequency(settings.midHighCrossover);
+    HP2.setCutoffFrequency(settings.midHighCrossover);
+
+    inputGain.setGainDecibels(settings.inputGain);
+    outputGain.setGainDecibels(settings.outputGain);
+}
+
+void ReferenceChain::splitBands(const juce::AudioBuffer<float>& inputBuffer) {
+
+    for (auto& fb : filterBuffers) {
+        fb = inputBuffer;
+    }
+
+    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
+    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
+    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
+
+    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);
+    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);
+    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);
+
+    LP1.process(fb0Ctx);
+    AP2.process(fb0Ctx);
+
+    HP1.process(fb1Ctx);
+    filterBuffers[2] = filterBuffers[1];
+    LP2.process(fb1Ctx);
+
+    HP2.process(fb2Ctx);
+}
+
+void ReferenceChain::process(juce::AudioBuffer<float>& buffer, const ChainSettings& settings) {
+    juce::ScopedNoDenormals noDenormals;
+
+    updateState(settings);
+
+    applyGain(buffer, inputGain);
+
+    splitBands(buffer);
+
+    for (size_t i = 0; i < filterBuffers.size(); ++i) {
+        auto block = juce::dsp::AudioBlock<float>(filterBuffers[i]);
+        auto context = juce::dsp::ProcessContextReplacing<float>(block);
+        context.isBypassed = settings.bands[i].bypassed;
+        compressor[i].process(context);
+    }
+
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = buffer.getNumChannels();
+
+    buffer.clear();
+
+    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source) {
+        for (auto i = 0; i < nc; ++i) {
+            inputBuffer.addFrom(i, 0, source, i, 0, ns);
+        }
+    };
+
+    auto bandsAreSoloed = false;
+    for (auto& band : settings.bands) {
+        if (band.solo) {
+            bandsAreSoloed = true;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < settings.bands.size(); ++i) {
+        auto& band = settings.bands[i];
+        if (bandsAreSoloed ? band.solo : !band.mute)
+            addFilterBand(buffer, filterBuffers[i]);
+    }
+
+    applyGain(buffer, outputGain);
+}
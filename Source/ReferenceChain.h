@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ReferenceChain.h
+    Created: 19 Oct 2026
+
+    Frozen copy of the original processing chain: juce::dsp LinkwitzRileyFilter,
+    Compressor and Gain objects, splitBands by copy-assigning AudioBuffers.
+    Every optimised path is measured against this (see EquivalenceHarness).
+
+    Do not optimise or "fix" anything in here - it allocates, it is slow, and
+    that is the point.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ChainSettings.h"
+
+class ReferenceChain {
+public:
+    ReferenceChain();
+
+    void prepare(double sampleRate, int numChannels, int samplesPerBlock);
+    void process(juce::AudioBuffer<float>& buffer, const ChainSettings& settings);
+
+private:
+    void updateState(const ChainSettings& settings);
+    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
+
+    template<typename T, typename U>
+    void applyGain(T& buffer, U& gain) {
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        gain.process(ctx);
+    }
+
+    std::array<juce::dsp::Compressor<float>, 3> compressor;
+
+    using  Filter = juce::dsp::LinkwitzRileyFilter<float>;
+    // fc0  fc1
+    Filter  LP1, AP2,
+        HP1, LP2,
+        HP2;
+
+    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
+
+    juce::dsp::Gain<float> inputGain, outputGain;
+
+    JUCE_DECLARE_NON_COPYABLE(ReferenceChain)
+};
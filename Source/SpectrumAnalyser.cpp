@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+namespace {
+    // The smoothed curve follows rises quickly and falls at this rate, like a meter.
+    constexpr float attack = 0.6f;
+    constexpr float releaseDecibelsPerSecond = 60.0f;
+}
+
+//==============================================================================
+class SpectrumAnalyser::Worker : public juce::Thread {
+public:
+    explicit Worker(SpectrumAnalyser& a) : juce::Thread("SpectrumAnalyser"), analyser(a) {}
+
+    void run() override {
+        const auto frameMilliseconds = 1000.0 / maxFramesPerSecond;
+
+        while (!threadShouldExit()) {
+            const auto started = juce::Time::getMillisecondCounterHiRes();
+
+            if (analyser.analyse())
+                analyser.frameNumber.fetch_add(1, std::memory_order_release);
+
+            // Capped frame rate: sleep for whatever is left of this frame.
+            const auto elapsed = juce::Time::getMillisecondCounterHiRes() - started;
+            wait(juce::jmax(1, (int)(frameMilliseconds - elapsed)));
+        }
+    }
+
+private:
+    SpectrumAnalyser& analyser;
+};
+
+//==============================================================================
+SpectrumAnalyser::SpectrumAnalyser()
+    : fftData((size_t)fftSize * 2) {
+
+    for (auto& channel : channels) {
+        channel.samples.resize((size_t)fifoSize);
+        channel.window.resize((size_t)fftSize);
+        channel.smoothed.fill(minDecibels);
+    }
+
+    for (auto& spectrum : published)
+        spectrum.fill(minDecibels);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser() {
+    if (worker != nullptr)
+        worker->stopThread(2000);
+}
+
+void SpectrumAnalyser::prepare(double sampleRate) noexcept {
+    preparedSampleRate.store(sampleRate, std::memory_order_relaxed);
+}
+
+void SpectrumAnalyser::push(Stream stream, const float* const* source, int numChannels, int numSamples) noexcept {
+    if (!active.load(std::memory_order_relaxed) || numChannels == 0)
+        return;
+
+    auto& channel = channels[(size_t)stream];
+
+    // If the worker has fallen behind, the samples that don't fit are dropped; it only wants the newest anyway.
+    const juce::AbstractFifo::ScopedWrite write(channel.fifo, numSamples);
+
+    auto downmix = [&](int start, int size, int offset) {
+        auto* destination = channel.samples.data() + start;
+
+        juce::FloatVectorOperations::copy(destination, source[0] + offset, size);
+        if (numChannels > 1) {
+            juce::FloatVectorOperations::add(destination, source[1] + offset, size);
+            juce::FloatVectorOperations::multiply(destination, 0.5f, size);
+        }
+    };
+
+    if (write.blockSize1 > 0)
+        downmix(write.startIndex1, write.blockSize1, 0);
+    if (write.blockSize2 > 0)
+        downmix(write.startIndex2, write.blockSize2, write.blockSize1);
+}
+
+//==============================================================================
+void SpectrumAnalyser::addViewer() {
+    if (numViewers++ > 0)
+        return;
+
+    // Whatever is still queued from the last time is stale, and the curves start from silence.
+    for (auto& channel : channels) {
+        channel.fifo.reset();
+        channel.numNew = 0;
+        std::fill(channel.window.begin(), channel.window.end(), 0.0f);
+        channel.smoothed.fill(minDecibels);
+    }
+
+    active.store(true, std::memory_order_relaxed);
+
+    worker = std::make_unique<Worker>(*this);
+    worker->startThread(3);
+}
+
+void SpectrumAnalyser::removeViewer() {
+    jassert(numViewers > 0);
+
+    if (--numViewers > 0)
+        return;
+
+    active.store(false, std::memory_order_relaxed);
+
+    worker->stopThread(2000);
+    worker.reset();
+}
+
+void SpectrumAnalyser::getSpectrum(Stream stream, Spectrum& destination) const noexcept {
+    const juce::SpinLock::ScopedLockType lock(publishLock);
+    destination = published[(size_t)stream];
+}
+
+float SpectrumAnalyser::getPointFrequency(float point) noexcept {
+    return minFrequency * std::pow(maxFrequency / minFrequency, point / (float)(numPoints - 1));
+}
+
+float SpectrumAnalyser::getPointForFrequency(float frequency) noexcept {
+    return (float)(numPoints - 1) * std::log(frequency / minFrequency) / std::log(maxFrequency / minFrequency);
+}
+
+//==============================================================================
+void SpectrumAnalyser::setUpBins(double sampleRate) {
+    binSampleRate = sampleRate;
+
+    const auto binsPerHertz = (float)(fftSize / sampleRate);
+    const auto numBins = fftSize / 2;
+
+    for (int p = 0; p <= numPoints; ++p)
+        firstBin[(size_t)p] = juce::jlimit(1, numBins, (int)std::ceil(getPointFrequency((float)p - 0.5f) * binsPerHertz));
+
+    for (int p = 0; p < numPoints; ++p)
+        centreBin[(size_t)p] = getPointFrequency((float)p) * binsPerHertz;
+
+    for (auto& channel : channels)
+        channel.smoothed.fill(minDecibels);
+}
+
+bool SpectrumAnalyser::readNewSamples(Channel& channel) {
+    const auto numReady = channel.fifo.getNumReady();
+    if (numReady == 0)
+        return false;
+
+    // Only the newest fftSize samples matter; anything older is skipped.
+    const auto numToKeep = juce::jmin(numReady, fftSize);
+    channel.fifo.finishedRead(numReady - numToKeep);
+
+    auto* window = channel.window.data();
+    std::memmove(window, window + numToKeep, sizeof(float) * (size_t)(fftSize - numToKeep));
+
+    const juce::AbstractFifo::ScopedRead read(channel.fifo, numToKeep);
+    auto* destination = window + fftSize - numToKeep;
+
+    std::copy_n(channel.samples.data() + read.startIndex1, read.blockSize1, destination);
+    std::copy_n(channel.samples.data() + read.startIndex2, read.blockSize2, destination + read.blockSize1);
+
+    channel.numNew += numToKeep;
+    return true;
+}
+
+bool SpectrumAnalyser::analyse() {
+    const auto sampleRate = preparedSampleRate.load(std::memory_order_relaxed);
+    if (sampleRate != binSampleRate)
+        setUpBins(sampleRate);
+
+    const auto numBins = fftSize / 2;
+    const auto release = releaseDecibelsPerSecond / (float)maxFramesPerSecond;
+
+    // A full scale sine reads 0 dB: the Hann window halves the peak bin, which is fftSize / 2 on its own.
+    const auto scale = 4.0f / (float)fftSize;
+
+    auto anyNew = false;
+
+    for (auto& channel : channels) {
+        // While the host isn't processing (transport stopped in some hosts) there is nothing to do.
+        if (!readNewSamples(channel) && channel.numNew == 0)
+            continue;
+
+        channel.numNew = 0;
+        anyNew = true;
+
+        std::copy(channel.window.begin(), channel.window.end(), fftData.begin());
+        windowing.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+        for (int p = 0; p < numPoints; ++p) {
+            const auto begin = firstBin[(size_t)p];
+            const auto end = firstBin[(size_t)p + 1];
+
+            float magnitude = 0;
+
+            if (end > begin) {
+                magnitude = *std::max_element(fftData.data() + begin, fftData.data() + end);
+            } else if (centreBin[(size_t)p] < (float)numBins) {
+                const auto bin = (int)centreBin[(size_t)p];
+                const auto fraction = centreBin[(size_t)p] - (float)bin;
+                magnitude = fftData[(size_t)bin] + fraction * (fftData[(size_t)bin + 1] - fftData[(size_t)bin]);
+            }
+
+            const auto level = juce::Decibels::gainToDecibels(magnitude * scale, minDecibels);
+            auto& smoothed = channel.smoothed[(size_t)p];
+
+            smoothed = level > smoothed ? smoothed + attack * (level - smoothed)
+                                        : juce::jmax(level, smoothed - release);
+        }
+    }
+
+    if (anyNew) {
+        const juce::SpinLock::ScopedLockType lock(publishLock);
+        for (int stream = 0; stream < numStreams; ++stream)
+            published[(size_t)stream] = channels[(size_t)stream].smoothed;
+    }
+
+    return anyNew;
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+    Created: 19 Oct 2026
+
+    Input and output spectrum for the editor's analyser (AnalyserPanel).
+
+    The audio thread does nothing but copy a mono downmix of each block
+    into one wait-free SPSC FIFO per stream, and only while a view is on
+    screen. A worker thread of our own, started with the first such view
+    and stopped with the last, drains the FIFOs at most maxFramesPerSecond
+    times a second, windows and transforms the newest fftSize samples of
+    each stream, reduces the bins to numPoints log-spaced points and
+    smooths them. Views copy the points under a spin lock the audio thread
+    never touches.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class SpectrumAnalyser {
+public:
+    enum Stream { input, output, numStreams };
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numPoints = 256;
+    static constexpr int maxFramesPerSecond = 30;
+
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float minDecibels = -100.0f;
+
+    using Spectrum = std::array<float, numPoints>;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser();
+
+    /** Any thread; the worker picks the new rate up with its next frame. */
+    void prepare(double sampleRate) noexcept;
+
+    /** Audio thread, once per block and stream. Returns at once while no view is showing. */
+    void push(Stream stream, const float* const* channels, int numChannels, int numSamples) noexcept;
+
+    //==============================================================================
+    // Message thread.
+
+    /** Views register while they are on screen; the worker only runs while there is one. */
+    void addViewer();
+    void removeViewer();
+
+    /** Goes up by one with every frame the worker publishes. */
+    juce::uint32 getFrameNumber() const noexcept { return frameNumber.load(std::memory_order_acquire); }
+
+    /** Smoothed level in dB at each point, minDecibels when silent. */
+    void getSpectrum(Stream stream, Spectrum& destination) const noexcept;
+
+    /** The points are spaced evenly on a log scale between minFrequency and maxFrequency. */
+    static float getPointFrequency(float point) noexcept;
+    static float getPointForFrequency(float frequency) noexcept;
+
+private:
+    class Worker;
+
+    static constexpr int fifoSize = fftSize * 4;    // a few frames even at 192 kHz
+
+    struct Channel {
+        juce::AbstractFifo fifo{ fifoSize };
+        std::vector<float> samples;
+
+        // Worker only.
+        std::vector<float> window;                  // the newest fftSize samples, oldest first
+        int numNew{ 0 };
+        Spectrum smoothed;
+    };
+
+    bool analyse();
+    bool readNewSamples(Channel& channel);
+    void setUpBins(double sampleRate);
+
+    std::array<Channel, numStreams> channels;
+    std::atomic<bool> active{ false };
+    std::atomic<double> preparedSampleRate{ 44100.0 };
+
+    // Worker only.
+    juce::dsp::FFT fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> windowing{ (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> fftData;
+    std::array<int, numPoints + 1> firstBin{};      // point p covers bins [firstBin[p], firstBin[p + 1])
+    std::array<float, numPoints> centreBin{};       // where that is empty, the bins around this are interpolated
+    double binSampleRate{ 0 };
+
+    mutable juce::SpinLock publishLock;
+    std::array<Spectrum, numStreams> published;
+    std::atomic<juce::uint32> frameNumber{ 0 };
+
+    int numViewers{ 0 };
+    std::unique_ptr<Worker> worker;
+
+    JUCE_DECLARE_NON_COPYABLE(SpectrumAnalyser)
+};
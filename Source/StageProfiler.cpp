@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+#if MBC_ENABLE_PROFILER
+
+double StageProfiler::getCyclesPerSecond() {
+   #if MBC_PROFILER_USES_TSC
+    // The TSC runs at a constant rate on anything recent, measure it once against the wall clock.
+    static const double rate = [] {
+        const auto ticksStart = juce::Time::getHighResolutionTicks();
+        const auto cyclesStart = now();
+        juce::Thread::sleep(20);
+        const auto cycles = (double)(now() - cyclesStart);
+        const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticksStart);
+        return cycles / seconds;
+    }();
+    return rate;
+   #else
+    return (double)juce::Time::getHighResolutionTicksPerSecond();
+   #endif
+}
+
+void StageProfiler::prepare(double sampleRate) noexcept {
+    cyclesPerSecond = getCyclesPerSecond();
+    cyclesPerSample = cyclesPerSecond / sampleRate;
+    reset();
+}
+
+int StageProfiler::getCycleBucket(juce::uint64 cycles) noexcept {
+    if (cycles < ((juce::uint64)1 << minOctave))
+        return 0;
+
+   #if JUCE_MSVC
+    unsigned long msb;
+    _BitScanReverse64(&msb, cycles);
+    const auto octave = (int)msb;
+   #else
+    const auto octave = 63 - __builtin_clzll(cycles);
+   #endif
+
+    // The two bits below the top one pick the quarter of the octave.
+    const auto fraction = (int)(cycles >> (octave - 2)) & (bucketsPerOctave - 1);
+    return juce::jmin(numCycleBuckets - 1, (octave - minOctave) * bucketsPerOctave + fraction);
+}
+
+double StageProfiler::getBucketCycles(int bucket) noexcept {
+    // Upper edge of the bucket, so percentiles err on the pessimistic side.
+    const auto octave = minOctave + bucket / bucketsPerOctave;
+    const auto fraction = bucket % bucketsPerOctave + 1;
+    return std::ldexp(1.0 + fraction / (double)bucketsPerOctave, octave);
+}
+
+void StageProfiler::beginBlock() noexcept {
+    if (!resetRequested.exchange(false, std::memory_order_acquire))
+        return;
+
+    for (auto& h : histograms) {
+        for (auto& b : h.buckets)
+            b.store(0, std::memory_order_relaxed);
+        h.numCalls.store(0, std::memory_order_relaxed);
+        h.totalCycles.store(0, std::memory_order_relaxed);
+        h.maxCycles.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& b : loadBuckets)
+        b.store(0, std::memory_order_relaxed);
+    totalLoad.store(0, std::memory_order_relaxed);
+    maxLoad.store(0, std::memory_order_relaxed);
+}
+
+void StageProfiler::addStage(Stage stage, juce::uint64 cycles) noexcept {
+    auto& h = histograms[(size_t)stage];
+
+    bump(h.buckets[getCycleBucket(cycles)], (juce::uint32)1);
+    bump(h.totalCycles, cycles);
+    bump(h.numCalls, (juce::uint64)1);
+
+    if (cycles > h.maxCycles.load(std::memory_order_relaxed))
+        h.maxCycles.store(cycles, std::memory_order_relaxed);
+}
+
+void StageProfiler::addBlock(int numSamples, juce::uint64 cycles) noexcept {
+    addStage(block, cycles);
+
+    if (numSamples <= 0 || cyclesPerSample <= 0)
+        return;
+
+    const auto load = (double)cycles / (numSamples * cyclesPerSample);
+
+    bump(loadBuckets[juce::jlimit(0, numLoadBuckets - 1, (int)(load * 100.0))], (juce::uint32)1);
+    bump(totalLoad, load);
+
+    if (load > maxLoad.load(std::memory_order_relaxed))
+        maxLoad.store(load, std::memory_order_relaxed);
+}
+
+//==============================================================================
+StageProfiler::Snapshot StageProfiler::getSnapshot() const {
+    Snapshot snapshot;
+
+    const auto microsecondsPerCycle = 1.0e6 / cyclesPerSecond;
+    const auto blockCycles = (double)histograms[block].totalCycles.load(std::memory_order_relaxed);
+
+    for (int s = 0; s < numStages; ++s) {
+        const auto& h = histograms[(size_t)s];
+        auto& stats = snapshot.stages[(size_t)s];
+
+        stats.numCalls = h.numCalls.load(std::memory_order_relaxed);
+        if (stats.numCalls == 0)
+            continue;
+
+        const auto totalCycles = (double)h.totalCycles.load(std::memory_order_relaxed);
+        stats.meanMicroseconds = totalCycles / (double)stats.numCalls * microsecondsPerCycle;
+        stats.maxMicroseconds = (double)h.maxCycles.load(std::memory_order_relaxed) * microsecondsPerCycle;
+        stats.cpuShare = blockCycles > 0 ? totalCycles / blockCycles : 0.0;
+
+        // The counters may move while we read them, the percentile is approximate anyway.
+        const auto target = (juce::uint64)std::ceil(0.99 * (double)stats.numCalls);
+        juce::uint64 seen = 0;
+        for (int b = 0; b < numCycleBuckets; ++b) {
+            seen += h.buckets[b].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                stats.p99Microseconds = juce::jmin(getBucketCycles(b) * microsecondsPerCycle, stats.maxMicroseconds);
+                break;
+            }
+        }
+    }
+
+    snapshot.numBlocks = snapshot.stages[block].numCalls;
+
+    if (snapshot.numBlocks > 0) {
+        snapshot.meanLoad = totalLoad.load(std::memory_order_relaxed) / (double)snapshot.numBlocks;
+        snapshot.maxLoad = maxLoad.load(std::memory_order_relaxed);
+
+        const auto target = (juce::uint64)std::ceil(0.99 * (double)snapshot.numBlocks);
+        juce::uint64 seen = 0;
+        for (int b = 0; b < numLoadBuckets; ++b) {
+            seen += loadBuckets[b].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                snapshot.p99Load = juce::jmin((b + 1) / 100.0, snapshot.maxLoad);
+                break;
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 19 Oct 2026
+
+    Per-instance timing of every stage of processBlock, read by the
+    diagnostics panel of the editor (ProfilerPanel).
+
+    The audio thread reads the CPU's cycle counter around each stage and
+    bumps a bucket of that stage's histogram; the GUI reads the histograms
+    whenever it likes. Nothing is locked or allocated while processing.
+
+    The block and its stages are timed on whichever thread processes the
+    block: with pipelining on (BlockPipeline), that is the worker, so the
+    shares still add up. The host thread's handover to the worker isn't
+    counted.
+
+    Enable with MBC_ENABLE_PROFILER=1 (the Profile configuration in the
+    .jucer). When disabled the scopes compile to nothing and the processor
+    carries no profiler state.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MBC_ENABLE_PROFILER
+ #define MBC_ENABLE_PROFILER 0
+#endif
+
+#if MBC_ENABLE_PROFILER && (JUCE_INTEL || defined (_M_X64) || defined (_M_IX86))
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+ #define MBC_PROFILER_USES_TSC 1
+#else
+ #define MBC_PROFILER_USES_TSC 0
+#endif
+
+class StageProfiler {
+public:
+    enum Stage {
+        block,          // everything one block goes through, the stages below included
+        updateState,
+        inputGain,
+        splitBands,
+        compressLow,
+        compressMid,
+        compressHigh,
+        sumBands,
+        outputGain,
+
+        numStages
+    };
+
+    static const char* getStageName(Stage stage) noexcept {
+        switch (stage) {
+            case block:         return "block";
+            case updateState:   return "updateState";
+            case inputGain:     return "input gain";
+            case splitBands:    return "splitBands";
+            case compressLow:   return "low band";
+            case compressMid:   return "mid band";
+            case compressHigh:  return "high band";
+            case sumBands:      return "band sum";
+            case outputGain:    return "output gain";
+            case numStages:     break;
+        }
+        return "";
+    }
+
+    static constexpr bool isEnabled() noexcept { return MBC_ENABLE_PROFILER != 0; }
+
+    /** What the panel shows for one stage, derived from the histograms. */
+    struct StageStats {
+        juce::uint64 numCalls{ 0 };
+        double meanMicroseconds{ 0 };
+        double p99Microseconds{ 0 };
+        double maxMicroseconds{ 0 };
+        double cpuShare{ 0 };           // of the time spent in the block
+    };
+
+    struct Snapshot {
+        std::array<StageStats, numStages> stages;
+
+        juce::uint64 numBlocks{ 0 };
+        double meanLoad{ 0 };           // block time / audio duration of the block
+        double p99Load{ 0 };
+        double maxLoad{ 0 };
+        double headroom() const noexcept { return 1.0 - maxLoad; }
+    };
+
+#if MBC_ENABLE_PROFILER
+    /** Cycle counter used by the scopes: TSC on x86, the high-resolution tick count elsewhere. */
+    static juce::uint64 now() noexcept {
+       #if MBC_PROFILER_USES_TSC
+        return (juce::uint64)__rdtsc();
+       #else
+        return (juce::uint64)juce::Time::getHighResolutionTicks();
+       #endif
+    }
+
+    /** Measures the counter against the wall clock once per process. Call from prepareToPlay. */
+    static double getCyclesPerSecond();
+
+    void prepare(double sampleRate) noexcept;
+
+    struct ScopedStage {
+        ScopedStage(StageProfiler& p, Stage s) noexcept : profiler(p), stage(s), start(now()) {}
+        ~ScopedStage() noexcept { profiler.addStage(stage, now() - start); }
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    private:
+        StageProfiler& profiler;
+        Stage stage;
+        juce::uint64 start;
+    };
+
+    /** Times a whole block and records its load against the block's duration. */
+    struct ScopedBlock {
+        ScopedBlock(StageProfiler& p, int n) noexcept : profiler(p), numSamples(n), start(now()) { p.beginBlock(); }
+        ~ScopedBlock() noexcept { profiler.addBlock(numSamples, now() - start); }
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    private:
+        StageProfiler& profiler;
+        int numSamples;
+        juce::uint64 start;
+    };
+
+    /** Message thread. */
+    Snapshot getSnapshot() const;
+    void reset() noexcept { resetRequested.store(true); }
+
+private:
+    // Four buckets per octave of cycles, from 2^minOctave up to beyond 2^(minOctave + numOctaves).
+    static constexpr int minOctave = 6;
+    static constexpr int numOctaves = 34;
+    static constexpr int bucketsPerOctave = 4;
+    static constexpr int numCycleBuckets = numOctaves * bucketsPerOctave;
+
+    // Load in whole percent of the deadline, the last bucket catches everything above.
+    static constexpr int numLoadBuckets = 256;
+
+    // Single writer (the audio thread), so a relaxed load and store is enough - no locked RMW.
+    template <typename T>
+    static void bump(std::atomic<T>& value, T amount) noexcept {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static int getCycleBucket(juce::uint64 cycles) noexcept;
+    static double getBucketCycles(int bucket) noexcept;
+
+    void beginBlock() noexcept;
+    void addStage(Stage stage, juce::uint64 cycles) noexcept;
+    void addBlock(int numSamples, juce::uint64 cycles) noexcept;
+
+    struct Histogram {
+        std::atomic<juce::uint32> buckets[numCycleBuckets]{};
+        std::atomic<juce::uint64> numCalls{ 0 };
+        std::atomic<juce::uint64> totalCycles{ 0 };
+        std::atomic<juce::uint64> maxCycles{ 0 };
+    };
+
+    std::array<Histogram, numStages> histograms;
+
+    std::atomic<juce::uint32> loadBuckets[numLoadBuckets]{};
+    std::atomic<double> totalLoad{ 0 };
+    std::atomic<double> maxLoad{ 0 };
+
+    std::atomic<bool> resetRequested{ false };
+
+    double cyclesPerSecond{ 1.0 };
+    double cyclesPerSample{ 0.0 };
+#else
+    struct ScopedStage { ScopedStage(StageProfiler&, Stage) noexcept {} };
+    struct ScopedBlock { ScopedBlock(StageProfiler&, int) noexcept {} };
+
+    void prepare(double) noexcept {}
+
+    Snapshot getSnapshot() const { return {}; }
+    void reset() noexcept {}
+#endif
+};
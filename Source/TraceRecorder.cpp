@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+#if MBC_ENABLE_TRACING
+
+namespace TraceRecorder {
+
+    namespace {
+        struct Event {
+            juce::int64 start, end;
+            const char* name;
+            int track;
+            int numSamples;
+        };
+
+        /** Bounded multi-producer, single-consumer ring. A producer claims an index with a CAS
+            only while there is room, fills the slot and publishes it through the slot's sequence
+            number; the consumer reads slots in order until it finds one that isn't published yet.
+        */
+        class Ring {
+        public:
+            explicit Ring(int minCapacity)
+                : capacity((juce::uint64)juce::nextPowerOfTwo(juce::jmax(1024, minCapacity))),
+                  slots(new Slot[(size_t)capacity]) {}
+
+            bool push(const Event& event) noexcept {
+                auto index = writeIndex.load(std::memory_order_relaxed);
+
+                do {
+                    if (index - readIndex.load(std::memory_order_acquire) >= capacity)
+                        return false;
+                } while (!writeIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+                auto& slot = slots[index & (capacity - 1)];
+                slot.event = event;
+                slot.sequence.store(index + 1, std::memory_order_release);
+                return true;
+            }
+
+            template <typename Fn>
+            void drain(Fn&& consume) {
+                auto index = readIndex.load(std::memory_order_relaxed);
+
+                for (;; ++index) {
+                    auto& slot = slots[index & (capacity - 1)];
+                    if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+                        break;
+
+                    consume(slot.event);
+                    readIndex.store(index + 1, std::memory_order_release);
+                }
+            }
+
+        private:
+            struct Slot {
+                std::atomic<juce::uint64> sequence{ 0 };
+                Event event;
+            };
+
+            const juce::uint64 capacity;
+            std::unique_ptr<Slot[]> slots;
+
+            alignas(64) std::atomic<juce::uint64> writeIndex{ 0 };
+            alignas(64) std::atomic<juce::uint64> readIndex{ 0 };
+        };
+
+        //==============================================================================
+        class Writer : public juce::Thread {
+        public:
+            Writer(std::unique_ptr<juce::FileOutputStream> streamToUse, Ring& ringToDrain)
+                : juce::Thread("TraceRecorder"), stream(std::move(streamToUse)), ring(ringToDrain),
+                  origin(juce::Time::getHighResolutionTicks()) {
+                *stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            }
+
+            ~Writer() override {
+                stopThread(2000);
+                drain();
+                *stream << "\n]}\n";
+                stream->flush();
+            }
+
+            void run() override {
+                while (!threadShouldExit()) {
+                    drain();
+                    wait(50);
+                }
+            }
+
+            void addTrackName(int track, const juce::String& name) {
+                const juce::ScopedLock sl(lock);
+                pendingNames.push_back({ track, name });
+            }
+
+        private:
+            void drain() {
+                {
+                    const juce::ScopedLock sl(lock);
+                    for (auto& t : pendingNames) {
+                        separator();
+                        *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t.first
+                                << ",\"args\":{\"name\":" << juce::JSON::toString(t.second) << "}}";
+                    }
+                    pendingNames.clear();
+                }
+
+                ring.drain([this](const Event& e) {
+                    separator();
+                    *stream << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.track
+                            << ",\"ts\":" << juce::String(toMicroseconds(e.start - origin), 3)
+                            << ",\"dur\":" << juce::String(toMicroseconds(e.end - e.start), 3);
+                    if (e.numSamples > 0)
+                        *stream << ",\"args\":{\"samples\":" << e.numSamples << "}";
+                    *stream << "}";
+                });
+
+                stream->flush();
+            }
+
+            void separator() {
+                *stream << (first ? "\n" : ",\n");
+                first = false;
+            }
+
+            static double toMicroseconds(juce::int64 ticks) {
+                return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+            }
+
+            std::unique_ptr<juce::FileOutputStream> stream;
+            Ring& ring;
+            const juce::int64 origin;
+            bool first{ true };
+
+            juce::CriticalSection lock;
+            std::vector<std::pair<int, juce::String>> pendingNames;
+        };
+
+        //==============================================================================
+        struct Recorder {
+            juce::CriticalSection lock;     // start/stop/tracks, never taken by the audio thread
+
+            // A ring is never freed while the process runs: an instance that is still
+            // processing while the trace stops only writes into a ring nobody reads.
+            std::vector<std::unique_ptr<Ring>> rings;
+            std::unique_ptr<Writer> writer;
+
+            std::atomic<Ring*> active{ nullptr };
+            std::atomic<juce::int64> numDropped{ 0 };
+
+            std::map<int, juce::String> tracks;
+            int nextTrack{ 1 };
+            bool startedFromEnvironment{ false };
+        };
+
+        Recorder& getRecorder() {
+            static Recorder recorder;
+            return recorder;
+        }
+    }
+
+    //==============================================================================
+    bool start(const juce::File& file, int capacity) {
+        auto& r = getRecorder();
+        const juce::ScopedLock sl(r.lock);
+
+        if (r.writer != nullptr)
+            return false;
+
+        file.deleteFile();
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (!stream->openedOk())
+            return false;
+
+        r.rings.push_back(std::make_unique<Ring>(capacity));
+        r.writer = std::make_unique<Writer>(std::move(stream), *r.rings.back());
+
+        for (auto& t : r.tracks)
+            r.writer->addTrackName(t.first, t.second);
+
+        r.numDropped = 0;
+        r.active.store(r.rings.back().get(), std::memory_order_release);
+        r.writer->startThread(2);
+        return true;
+    }
+
+    void stop() {
+        auto& r = getRecorder();
+        const juce::ScopedLock sl(r.lock);
+
+        r.active.store(nullptr, std::memory_order_release);
+        r.writer.reset();
+    }
+
+    bool isRecording() noexcept {
+        return getRecorder().active.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    juce::int64 getNumDropped() noexcept {
+        return getRecorder().numDropped.load(std::memory_order_relaxed);
+    }
+
+    int addTrack(const juce::String& name) {
+        auto& r = getRecorder();
+        const juce::ScopedLock sl(r.lock);
+
+        const auto track = r.nextTrack++;
+        r.tracks[track] = name + " #" + juce::String(track);
+
+        if (r.writer != nullptr)
+            r.writer->addTrackName(track, r.tracks[track]);
+        else if (r.tracks.size() == 1) {
+            const auto path = juce::SystemStats::getEnvironmentVariable("MBC_TRACE_FILE", {});
+            if (path.isNotEmpty())
+                r.startedFromEnvironment = start(juce::File::getCurrentWorkingDirectory().getChildFile(path));
+        }
+
+        return track;
+    }
+
+    void removeTrack(int track) {
+        auto& r = getRecorder();
+        const juce::ScopedLock sl(r.lock);
+
+        r.tracks.erase(track);
+
+        // A trace a tool started with start() runs until the tool stops it.
+        if (r.tracks.empty() && r.startedFromEnvironment) {
+            r.startedFromEnvironment = false;
+            stop();
+        }
+    }
+
+    void record(int track, const char* name, juce::int64 startTicks, juce::int64 endTicks, int numSamples) noexcept {
+        auto& r = getRecorder();
+
+        if (auto* ring = r.active.load(std::memory_order_acquire)) {
+            if (!ring->push({ startTicks, endTicks, name, track, numSamples }))
+                r.numDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+#endif
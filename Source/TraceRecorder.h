@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 19 Oct 2026
+
+    Timeline of what every instance did and when, written as Chrome
+    trace-event JSON (open it in Perfetto or chrome://tracing).
+
+    Audio threads only push fixed-size events into one preallocated
+    multi-producer ring; a background thread drains the ring into the file.
+    If the writer can't keep up, events are dropped and counted, the audio
+    thread never waits.
+
+    Enable with MBC_ENABLE_TRACING=1. In a host, tracing starts when the
+    first instance is created if MBC_TRACE_FILE names the output file, and
+    the file is closed when the last instance goes away. Offline tools call
+    start() and stop() themselves.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef MBC_ENABLE_TRACING
+ #define MBC_ENABLE_TRACING 0
+#endif
+
+namespace TraceRecorder {
+
+#if MBC_ENABLE_TRACING
+    /** Starts writing to file, keeping room for capacity events in memory (rounded up to a power of two).
+        Returns false if the file can't be opened or a trace is already running.
+    */
+    bool start(const juce::File& file, int capacity = 1 << 18);
+
+    /** Writes out what is left in the ring and closes the file. */
+    void stop();
+
+    bool isRecording() noexcept;
+    juce::int64 getNumDropped() noexcept;
+
+    /** One track (a row in the viewer) per processor instance. */
+    int addTrack(const juce::String& name);
+    void removeTrack(int track);
+
+    /** Audio thread. name must be a string literal, only the pointer is stored. */
+    void record(int track, const char* name, juce::int64 startTicks, juce::int64 endTicks, int numSamples) noexcept;
+
+    struct ScopedEvent {
+        ScopedEvent(int t, const char* n, int samples = 0) noexcept
+            : track(t), name(n), numSamples(samples), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedEvent() noexcept { record(track, name, start, juce::Time::getHighResolutionTicks(), numSamples); }
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedEvent)
+    private:
+        int track;
+        const char* name;
+        int numSamples;
+        juce::int64 start;
+    };
+#else
+    inline bool start(const juce::File&, int = 0) { return false; }
+    inline void stop() {}
+
+    inline bool isRecording() noexcept { return false; }
+    inline juce::int64 getNumDropped() noexcept { return 0; }
+
+    inline int addTrack(const juce::String&) { return 0; }
+    inline void removeTrack(int) {}
+
+    struct ScopedEvent { ScopedEvent(int, const char*, int = 0) noexcept {} };
+#endif
+}
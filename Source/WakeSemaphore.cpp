@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    WakeSemaphore.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "WakeSemaphore.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <time.h>
+#endif
+
+struct WakeSemaphore::Handle {
+   #if JUCE_WINDOWS
+    Handle() : semaphore(CreateSemaphore(nullptr, 0, LONG_MAX, nullptr)) {}
+    ~Handle() { CloseHandle(semaphore); }
+    HANDLE semaphore;
+   #elif JUCE_MAC || JUCE_IOS
+    Handle() : semaphore(dispatch_semaphore_create(0)) {}
+    ~Handle() { dispatch_release(semaphore); }
+    dispatch_semaphore_t semaphore;
+   #else
+    Handle() { sem_init(&semaphore, 0, 0); }
+    ~Handle() { sem_destroy(&semaphore); }
+    sem_t semaphore;
+   #endif
+};
+
+WakeSemaphore::WakeSemaphore() : handle(std::make_unique<Handle>()) {}
+
+WakeSemaphore::~WakeSemaphore() = default;
+
+void WakeSemaphore::signal() noexcept {
+   #if JUCE_WINDOWS
+    ReleaseSemaphore(handle->semaphore, 1, nullptr);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_signal(handle->semaphore);
+   #else
+    sem_post(&handle->semaphore);
+   #endif
+}
+
+void WakeSemaphore::wait(int milliseconds) noexcept {
+   #if JUCE_WINDOWS
+    WaitForSingleObject(handle->semaphore, (DWORD)milliseconds);
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_wait(handle->semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)milliseconds * 1000000));
+   #else
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += milliseconds / 1000;
+    deadline.tv_nsec += (long)(milliseconds % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_nsec -= 1000000000;
+        ++deadline.tv_sec;
+    }
+    sem_timedwait(&handle->semaphore, &deadline);
+   #endif
+}
@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    WakeSemaphore.h
+    Created: 19 Oct 2026
+
+    A counting semaphore on the platform's own primitive (a Win32 semaphore,
+    dispatch_semaphore, sem_t). signal() never takes a lock, unlike
+    juce::WaitableEvent, so the audio thread may wake a worker with it
+    (BlockPipeline, DspTaskPool).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class WakeSemaphore {
+public:
+    WakeSemaphore();
+    ~WakeSemaphore();
+
+    /** Lets one wait() through; real-time safe. */
+    void signal() noexcept;
+
+    /** Returns after a signal() or once the timeout has passed. */
+    void wait(int milliseconds) noexcept;
+
+private:
+    struct Handle;
+    std::unique_ptr<Handle> handle;
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+};
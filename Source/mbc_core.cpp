@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    mbc_core.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "mbc_core.h"
+#include "DspEngine.h"
+
+#include <cmath>
+
+struct mbc_engine {
+    DspEngine engine;
+};
+
+namespace {
+    // nyquist is 0 before the first prepare, the engine holds crossovers below it from then on.
+    bool isValid(const mbc_params& p, double nyquist) noexcept {
+        auto finite = [](float value) { return std::isfinite(value); };
+
+        if (!finite(p.low_mid_crossover_hz) || !finite(p.mid_high_crossover_hz)
+            || !finite(p.input_gain_db) || !finite(p.output_gain_db))
+            return false;
+
+        if (p.low_mid_crossover_hz <= 0.0f || p.low_mid_crossover_hz > p.mid_high_crossover_hz
+            || (nyquist > 0.0 && p.mid_high_crossover_hz >= nyquist))
+            return false;
+
+        for (const auto& band : p.bands) {
+            if (!finite(band.threshold_db) || !finite(band.ratio) || !finite(band.attack_ms) || !finite(band.release_ms))
+                return false;
+
+            if (band.ratio < 1.0f || band.attack_ms < 0.0f || band.release_ms < 0.0f)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+extern "C" {
+
+mbc_engine* mbc_create(void) {
+    return new (std::nothrow) mbc_engine();
+}
+
+void mbc_destroy(mbc_engine* engine) {
+    delete engine;
+}
+
+void mbc_get_default_params(mbc_params* params) {
+    if (params != nullptr)
+        *params = DspEngine::getDefaultParameters();
+}
+
+int mbc_prepare(mbc_engine* engine, double sample_rate, int num_channels, int max_block_size) {
+    if (engine == nullptr || sample_rate <= 0 || num_channels < 1 || num_channels > MBC_MAX_CHANNELS || max_block_size < 1)
+        return MBC_ERROR_INVALID_ARGUMENT;
+
+    try {
+        // The engine keeps its state over a re-prepare at the same rate; this call promises a clean one.
+        engine->engine.prepare(sample_rate, num_channels, max_block_size);
+        engine->engine.reset();
+    }
+    catch (const std::bad_alloc&) {
+        return MBC_ERROR_OUT_OF_MEMORY;
+    }
+
+    return MBC_OK;
+}
+
+int mbc_set_num_threads(mbc_engine* engine, int num_threads) {
+    if (engine == nullptr || num_threads < 1)
+        return MBC_ERROR_INVALID_ARGUMENT;
+
+    try {
+        engine->engine.setNumThreads(num_threads);
+    }
+    catch (const std::bad_alloc&) {
+        return MBC_ERROR_OUT_OF_MEMORY;
+    }
+
+    return MBC_OK;
+}
+
+void mbc_set_high_quality(mbc_engine* engine, int enabled) {
+    if (engine == nullptr)
+        return;
+
+    auto quality = engine->engine.getQuality();
+    quality.oversampledDetector = enabled != 0;
+    engine->engine.setQuality(quality);
+}
+
+int mbc_set_params(mbc_engine* engine, const mbc_params* params) {
+    if (engine == nullptr || params == nullptr)
+        return MBC_ERROR_INVALID_ARGUMENT;
+
+    const auto nyquist = engine->engine.isPrepared() ? engine->engine.getSampleRate() * 0.5 : 0.0;
+    if (!isValid(*params, nyquist))
+        return MBC_ERROR_INVALID_ARGUMENT;
+
+    engine->engine.setParameters(*params);
+    return MBC_OK;
+}
+
+void mbc_process_planar(mbc_engine* engine, float* const* channels, int num_channels, int num_samples) {
+    if (engine == nullptr || !engine->engine.isPrepared() || num_channels > engine->engine.getNumChannels())
+        return;
+
+    engine->engine.process(channels, num_channels, num_samples);
+}
+
+void mbc_process_interleaved(mbc_engine* engine, float* frames, int num_channels, int num_frames) {
+    if (engine == nullptr || !engine->engine.isPrepared() || num_channels > engine->engine.getNumChannels())
+        return;
+
+    engine->engine.processInterleaved(frames, num_channels, num_frames);
+}
+
+}
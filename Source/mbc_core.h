@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    mbc_core.h
+    Created: 19 Oct 2026
+
+    C API of the processing chain (input gain, LR4 three-band crossover,
+    three compressors, band sum, output gain) without the plugin around it.
+    Built as Core/multiband_comp_core.jucer (static) and
+    Core/multiband_comp_core_shared.jucer (shared, defines MBC_CORE_SHARED;
+    define it too when including this header against the shared library).
+    Both link nothing but juce_core and juce_audio_basics.
+
+    mbc_create and mbc_prepare are the only calls that allocate. After
+    mbc_prepare, mbc_set_params and the process calls are real-time safe:
+    no allocation, no locks, no system calls. One engine must not be used
+    from two threads at once; separate engines are independent.
+
+  ==============================================================================
+*/
+
+#ifndef MBC_CORE_H
+#define MBC_CORE_H
+
+#if defined(MBC_CORE_SHARED)
+ #if defined(_WIN32)
+  #if defined(MBC_CORE_BUILDING)
+   #define MBC_CORE_API __declspec(dllexport)
+  #else
+   #define MBC_CORE_API __declspec(dllimport)
+  #endif
+ #else
+  #define MBC_CORE_API __attribute__((visibility ("default")))
+ #endif
+#else
+ #define MBC_CORE_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MBC_NUM_BANDS 3
+#define MBC_MAX_CHANNELS 32
+
+enum {
+    MBC_OK = 0,
+    MBC_ERROR_INVALID_ARGUMENT = -1,
+    MBC_ERROR_OUT_OF_MEMORY = -2
+};
+
+typedef struct mbc_band_params {
+    float threshold_db;     /* -60 .. 12 */
+    float ratio;            /* >= 1 */
+    float attack_ms;        /* >= 0 */
+    float release_ms;       /* >= 0 */
+    int bypassed;           /* the band passes through uncompressed */
+    int mute;
+    int solo;               /* if any band is soloed, only soloed bands are heard */
+} mbc_band_params;
+
+typedef struct mbc_params {
+    float low_mid_crossover_hz;     /* > 0, <= mid_high_crossover_hz */
+    float mid_high_crossover_hz;    /* < sample_rate / 2 */
+    float input_gain_db;
+    float output_gain_db;
+    mbc_band_params bands[MBC_NUM_BANDS];   /* low, mid, high */
+} mbc_params;
+
+typedef struct mbc_engine mbc_engine;
+
+/** Returns NULL if out of memory. */
+MBC_CORE_API mbc_engine* mbc_create(void);
+MBC_CORE_API void mbc_destroy(mbc_engine* engine);
+
+/** The plugin's default settings. */
+MBC_CORE_API void mbc_get_default_params(mbc_params* params);
+
+/** Allocates the state for up to max_block_size samples per call and clears it.
+    Parameters set before stay; the coefficients are recomputed for the new rate.
+    The first prepare fades the gains in over 50 ms, like the plugin does.
+*/
+MBC_CORE_API int mbc_prepare(mbc_engine* engine, double sample_rate, int num_channels, int max_block_size);
+
+/** Worker threads for process calls, 1 (the default) runs on the calling thread only.
+    Output is bit-identical either way. Allocates and starts threads: not for real-time use.
+*/
+MBC_CORE_API int mbc_set_num_threads(mbc_engine* engine, int num_threads);
+
+/** Non-zero for offline renders: the compressors detect peaks between samples too, at
+    several times the cost. No latency either way; can be switched between process calls.
+*/
+MBC_CORE_API void mbc_set_high_quality(mbc_engine* engine, int enabled);
+
+/** Only values that changed cost anything. Gains ramp over 50 ms, everything else steps.
+    Returns MBC_ERROR_INVALID_ARGUMENT and keeps the previous settings if a value is not
+    finite, a ratio is below 1, a time is negative, a crossover is not above 0 Hz (or, once
+    prepared, not below Nyquist) or the low/mid crossover is above the mid/high one.
+    Until the first call the engine runs with mbc_get_default_params.
+*/
+MBC_CORE_API int mbc_set_params(mbc_engine* engine, const mbc_params* params);
+
+/** In place, any number of samples; longer calls than max_block_size are processed in parts.
+    num_channels may be less than prepared, never more.
+*/
+MBC_CORE_API void mbc_process_planar(mbc_engine* engine, float* const* channels, int num_channels, int num_samples);
+MBC_CORE_API void mbc_process_interleaved(mbc_engine* engine, float* frames, int num_channels, int num_frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif